@@ -0,0 +1,441 @@
+#pragma once
+#ifndef PYCPP_ARGUMENTS_H
+#define PYCPP_ARGUMENTS_H
+
+/*
+    Argument packing for the vectorcall protocol. Instead of building a format string and
+    letting Py_BuildValue allocate a fresh argument tuple for every call, the arguments are
+    converted one by one into a stack array of PyObject*. Objects (and PyObject*) are passed
+    through as borrowed references, every other argument is converted to a new reference
+    which is owned by the array and released when it goes out of scope.
+
+    Keyword arguments are passed by appending a Keywords pack as the last argument:
+
+        static const pycpp::Keywords predictKw("batch_size", "verbose");
+        predict(x, predictKw(32, false)); // predict(x, batch_size=32, verbose=False)
+
+    The tuple of keyword names is built once per Keywords object (and interpreter) and handed
+    to vectorcall as kwnames, so no kwargs dict is created for the call.
+*/
+
+#include "Python.h"
+#include "Object.h"
+#include "Error.h"
+#include "Interpreter.h"
+#include "AttributeName.h"
+#include <complex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace pycpp
+{
+    namespace detail
+    {
+        // ArgConverter<T>::Convert returns a PyObject* for the given value. If borrowed is true,
+        // the returned pointer does not carry a reference and must not be decreffed.
+        template<typename T, typename U = void>
+        struct ArgConverter
+        {
+            static_assert(sizeof(T) == 0, "ArgConverter: Type not supported as argument");
+        };
+
+        template<typename T>
+        struct ArgConverter<T, typename std::enable_if_t<std::is_base_of_v<Object, T>>>
+        {
+            constexpr static bool borrowed = true;
+
+            static PyObject* Convert(const T& pyObj)
+            {
+                if (!pyObj)
+                    throw Error("Null Object passed as argument");
+                return pyObj.get();
+            }
+        };
+
+        template<>
+        struct ArgConverter<PyObject*>
+        {
+            constexpr static bool borrowed = true;
+
+            static PyObject* Convert(PyObject* pPyObj)
+            {
+                if (!pPyObj)
+                    throw Error("Null PyObject* passed as argument");
+                return pPyObj;
+            }
+        };
+
+        // Py_True and Py_False live as long as the interpreter does
+        template<>
+        struct ArgConverter<bool>
+        {
+            constexpr static bool borrowed = true;
+
+            static PyObject* Convert(bool val) noexcept
+            {
+                return val ? Py_True : Py_False;
+            }
+        };
+
+        template<typename T>
+        struct ArgConverter<T, typename std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+        {
+            constexpr static bool borrowed = false;
+
+            static PyObject* Convert(T val)
+            {
+                PyObject* pRet = nullptr;
+                if constexpr (std::is_signed_v<T> && sizeof(T) <= sizeof(long))
+                    pRet = PyLong_FromLong(static_cast<long>(val));
+                else if constexpr (std::is_signed_v<T>)
+                    pRet = PyLong_FromLongLong(static_cast<long long>(val));
+                else if constexpr (sizeof(T) <= sizeof(unsigned long))
+                    pRet = PyLong_FromUnsignedLong(static_cast<unsigned long>(val));
+                else
+                    pRet = PyLong_FromUnsignedLongLong(static_cast<unsigned long long>(val));
+                if (!pRet)
+                    Error::ThrowCurrent();
+                return pRet;
+            }
+        };
+
+        template<typename T>
+        struct ArgConverter<T, typename std::enable_if_t<std::is_floating_point_v<T>>>
+        {
+            constexpr static bool borrowed = false;
+
+            static PyObject* Convert(T val)
+            {
+                auto pRet = PyFloat_FromDouble(static_cast<double>(val));
+                if (!pRet)
+                    Error::ThrowCurrent();
+                return pRet;
+            }
+        };
+
+        template<>
+        struct ArgConverter<std::complex<double>>
+        {
+            constexpr static bool borrowed = false;
+
+            static PyObject* Convert(const std::complex<double>& val)
+            {
+                auto pRet = PyComplex_FromDoubles(val.real(), val.imag());
+                if (!pRet)
+                    Error::ThrowCurrent();
+                return pRet;
+            }
+        };
+
+        template<>
+        struct ArgConverter<const char*>
+        {
+            constexpr static bool borrowed = false;
+
+            static PyObject* Convert(const char* str)
+            {
+                auto pRet = PyUnicode_FromString(str);
+                if (!pRet)
+                    Error::ThrowCurrent();
+                return pRet;
+            }
+        };
+
+        template<>
+        struct ArgConverter<char*> : ArgConverter<const char*>
+        {};
+
+        template<>
+        struct ArgConverter<const wchar_t*>
+        {
+            constexpr static bool borrowed = false;
+
+            static PyObject* Convert(const wchar_t* str)
+            {
+                auto pRet = PyUnicode_FromWideChar(str, -1);
+                if (!pRet)
+                    Error::ThrowCurrent();
+                return pRet;
+            }
+        };
+
+        template<>
+        struct ArgConverter<wchar_t*> : ArgConverter<const wchar_t*>
+        {};
+
+        // sized strings skip the strlen PyUnicode_FromString would have to do
+        template<>
+        struct ArgConverter<std::string_view>
+        {
+            constexpr static bool borrowed = false;
+
+            static PyObject* Convert(std::string_view str)
+            {
+                auto pRet = PyUnicode_FromStringAndSize(str.data(), static_cast<Py_ssize_t>(str.size()));
+                if (!pRet)
+                    Error::ThrowCurrent();
+                return pRet;
+            }
+        };
+
+        template<>
+        struct ArgConverter<std::string> : ArgConverter<std::string_view>
+        {};
+
+        template<>
+        struct ArgConverter<std::wstring>
+        {
+            constexpr static bool borrowed = false;
+
+            static PyObject* Convert(const std::wstring& str)
+            {
+                auto pRet = PyUnicode_FromWideChar(str.data(), static_cast<Py_ssize_t>(str.size()));
+                if (!pRet)
+                    Error::ThrowCurrent();
+                return pRet;
+            }
+        };
+
+        template<typename T>
+        using ArgConverterFor = ArgConverter<std::decay_t<T>>;
+    }
+
+    template<size_t N>
+    class Keywords;
+
+    namespace detail
+    {
+        // Values for the keyword names of a Keywords object. Only references are held, so this is only
+        // meant to live until the end of the full expression it is created in
+        template<size_t N, typename... Vals>
+        class KeywordArgs
+        {
+            static_assert(sizeof...(Vals) == N, "Keywords: number of values does not match number of names");
+        public:
+            constexpr KeywordArgs(const Keywords<N>& names, const Vals&... vals) noexcept
+                : m_names(names), m_values(vals...)
+            {}
+
+            [[nodiscard]] const Keywords<N>& names() const noexcept
+            {
+                return m_names;
+            }
+
+            [[nodiscard]] const std::tuple<const Vals&...>& values() const noexcept
+            {
+                return m_values;
+            }
+
+        private:
+            const Keywords<N>& m_names;
+            std::tuple<const Vals&...> m_values;
+        };
+
+        template<typename T>
+        struct isKeywordArgs : std::false_type
+        {};
+
+        template<size_t N, typename... Vals>
+        struct isKeywordArgs<KeywordArgs<N, Vals...>> : std::true_type
+        {};
+
+        template<typename... Args>
+        struct KeywordCount
+        {
+            constexpr static size_t value = 0;
+        };
+
+        template<typename Last>
+        struct KeywordCount<Last>
+        {
+            constexpr static size_t value = 0;
+        };
+
+        template<size_t N, typename... Vals>
+        struct KeywordCount<KeywordArgs<N, Vals...>>
+        {
+            constexpr static size_t value = N;
+        };
+
+        template<typename First, typename Second, typename... Rest>
+        struct KeywordCount<First, Second, Rest...> : KeywordCount<Second, Rest...>
+        {
+            static_assert(!isKeywordArgs<First>::value, "Keyword arguments have to be passed last");
+        };
+
+        template<typename T>
+        std::tuple<const T&> FlattenArg(const T& arg) noexcept
+        {
+            return std::tuple<const T&>(arg);
+        }
+
+        template<size_t N, typename... Vals>
+        const std::tuple<const Vals&...>& FlattenArg(const KeywordArgs<N, Vals...>& kwargs) noexcept
+        {
+            return kwargs.values();
+        }
+
+        template<typename T>
+        PyObject* KwnamesOf(const T&) noexcept
+        {
+            return nullptr;
+        }
+
+        template<size_t N, typename... Vals>
+        PyObject* KwnamesOf(const KeywordArgs<N, Vals...>& kwargs)
+        {
+            return kwargs.names().Kwnames();
+        }
+
+        // only the last argument may hold keywords
+        template<typename... Args>
+        PyObject* LastKwnames(const Args&... args)
+        {
+            PyObject* pKwnames = nullptr;
+            ((pKwnames = KwnamesOf(args)), ...);
+            return pKwnames;
+        }
+
+        /*
+            Fixed size argument array as expected by PyObject_Vectorcall. Slot 0 is left empty so the
+            callee may use it as scratch space (PY_VECTORCALL_ARGUMENTS_OFFSET), which allows bound methods
+            to prepend self without copying the arguments.
+        */
+        template<typename... Args>
+        class VectorcallArgs
+        {
+        public:
+            constexpr static size_t count = sizeof...(Args);
+
+            explicit VectorcallArgs(const Args&... args)
+            {
+                size_t idx = 1;
+                ((m_storage.ptrs[idx++] = ArgConverterFor<Args>::Convert(args)), ...);
+            }
+
+            VectorcallArgs(const VectorcallArgs& other) = delete;
+            VectorcallArgs& operator=(const VectorcallArgs& other) = delete;
+
+            [[nodiscard]] PyObject* const* data() const noexcept
+            {
+                return m_storage.ptrs + 1;
+            }
+
+            // Puts pSelf into the scratch slot in front of the arguments, as PyObject_VectorcallMethod
+            // expects it. pSelf is borrowed and not released by the array
+            [[nodiscard]] PyObject* const* dataWithSelf(PyObject* pSelf) noexcept
+            {
+                m_storage.ptrs[0] = pSelf;
+                return m_storage.ptrs;
+            }
+
+            // keyword values at the end of the array do not count as positional arguments
+            [[nodiscard]] constexpr static size_t nargsf(size_t keywordCount = 0) noexcept
+            {
+                return (count - keywordCount) | PY_VECTORCALL_ARGUMENTS_OFFSET;
+            }
+
+        private:
+            constexpr static bool s_owned[] = { false, !ArgConverterFor<Args>::borrowed... };
+
+            // Separate member so already converted arguments are released if a later conversion throws
+            struct Storage
+            {
+                PyObject* ptrs[count + 1] = {};
+
+                ~Storage()
+                {
+                    for (size_t idx = 0; idx <= count; ++idx)
+                    {
+                        if (s_owned[idx])
+                            Py_XDECREF(ptrs[idx]);
+                    }
+                }
+            } m_storage;
+        };
+
+        /*
+            Packs args into a VectorcallArgs array and calls fn(argArray, nargsf, pKwnames). Values of a
+            trailing KeywordArgs are appended after the positional arguments as vectorcall expects them.
+        */
+        template<typename Fn, typename... Args>
+        decltype(auto) WithVectorcallArgs(Fn&& fn, const Args&... args)
+        {
+            constexpr size_t keywordCount = KeywordCount<Args...>::value;
+            if constexpr (keywordCount == 0)
+            {
+                VectorcallArgs<Args...> argArray(args...);
+                return fn(argArray, argArray.nargsf(), static_cast<PyObject*>(nullptr));
+            }
+            else
+            {
+                PyObject* pKwnames = LastKwnames(args...);
+                return std::apply([&](const auto&... flatArgs) -> decltype(auto)
+                    {
+                        VectorcallArgs<std::remove_cv_t<std::remove_reference_t<decltype(flatArgs)>>...> argArray(flatArgs...);
+                        return fn(argArray, argArray.nargsf(keywordCount), pKwnames);
+                    }, std::tuple_cat(FlattenArg(args)...));
+            }
+        }
+    }
+
+    /*
+        Names for keyword arguments. Create it once (e.g. as a static at the call site) and
+        pass keywords(values...) as the last argument of a call.
+    */
+    template<size_t N>
+    class Keywords
+    {
+        static_assert(N > 0, "Keywords: at least one name is required");
+    public:
+        template<typename... Names>
+        constexpr explicit Keywords(const Names&... names) noexcept
+            : m_names{ names... }
+        {
+            static_assert(sizeof...(Names) == N, "Keywords: number of names does not match N");
+        }
+
+        Keywords(const Keywords& other) = delete;
+        Keywords& operator=(const Keywords& other) = delete;
+
+        template<typename... Vals>
+        [[nodiscard]] detail::KeywordArgs<N, Vals...> operator()(const Vals&... vals) const noexcept
+        {
+            return detail::KeywordArgs<N, Vals...>(*this, vals...);
+        }
+
+        // Borrowed tuple of interned names for the current interpreter. Built on first use
+        [[nodiscard]] PyObject* Kwnames() const
+        {
+            return m_kwnames.Get([this]()
+                {
+                    Object kwnames = PyTuple_New(N);
+                    if (!kwnames)
+                        Error::ThrowCurrent();
+                    for (size_t idx = 0; idx < N; ++idx)
+                    {
+                        auto pName = detail::InternName(m_names[idx]);
+                        Py_INCREF(pName);
+                        PyTuple_SET_ITEM(kwnames.get(), idx, pName); // steals the reference
+                    }
+                    return kwnames;
+                });
+        }
+
+        [[nodiscard]] constexpr static size_t size() noexcept
+        {
+            return N;
+        }
+
+    private:
+        const char* m_names[N];
+        detail::InterpreterLocalRef m_kwnames;
+    };
+
+    template<typename... Names>
+    Keywords(const Names&...)->Keywords<sizeof...(Names)>;
+}
+
+#endif // PYCPP_ARGUMENTS_H
@@ -0,0 +1,166 @@
+#pragma once
+#ifndef PYCPP_ASYNC_H
+#define PYCPP_ASYNC_H
+
+/*
+    Bridge between C++20 coroutines and asyncio. EventLoop runs an asyncio event loop forever on
+    its own thread. Awaiting a Python coroutine, asyncio.Future or Task schedules it on that loop
+    and suspends the C++ coroutine without blocking any thread; it is resumed once the Python side
+    completed, so any number of Python I/O calls can be in flight at the same time:
+
+        pycpp::EventLoop loop;
+
+        MyTask Fetch(pycpp::EventLoop& loop, const pycpp::Callable& fetch)
+        {
+            std::string body = co_await loop.Call<std::string>(fetch, "https://...");
+            ...
+        }
+
+    The result is converted to T on the loop thread, exceptions (including cancellation) are
+    rethrown by co_await as Error. The C++ coroutine is resumed on the loop thread without holding
+    the GIL, so it should hand longer work to another thread; the loop is blocked until the
+    coroutine suspends again. Results can not be Objects, since those would be released without
+    the GIL; convert them on the loop thread instead.
+
+    Destroying the EventLoop cancels all Python tasks still running on it, which resumes their
+    C++ coroutines with an Error.
+*/
+
+#include "Python.h"
+#include "Defines.h"
+#include "Object.h"
+#include "Error.h"
+#include "TypeTraits.h"
+#include "Interpreter.h"
+#include "Callable.h"
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace pycpp
+{
+    namespace detail
+    {
+        // Shared by the awaiter and the done callback of the scheduled Python awaitable
+        struct PYCPP_API AsyncState
+        {
+            virtual ~AsyncState() = default;
+
+            // Converts the result of the awaitable, called on the loop thread with the GIL held
+            virtual void SetResult(const Object& result) = 0;
+
+            std::coroutine_handle<> handle;
+            std::exception_ptr exception;
+            // set by whichever of await_suspend and the done callback finishes last
+            std::atomic<bool> done = false;
+        };
+
+        // Schedules the awaitable on pLoop (stealing the reference) and completes pState once it is
+        // done. Returns false if the awaiting coroutine should not be suspended, because the result
+        // is already there or scheduling failed
+        PYCPP_API bool ScheduleAwaitable(PyObject* pLoop, PyObject* pAwaitable, AsyncState* pState) noexcept;
+
+        // Releases a reference, acquiring the GIL if needed
+        PYCPP_API void ReleaseWithGIL(PyObject* pObject) noexcept;
+    }
+
+    // Awaiter for a Python awaitable running on an EventLoop, see EventLoop::Await
+    template<typename T = void>
+    class Awaitable : private detail::AsyncState
+    {
+        static_assert(!std::is_base_of_v<Object, std::decay_t<T>>,
+            "Awaitable: results can not be Objects, convert them to a C++ type on the loop thread");
+    public:
+        // Takes ownership of pAwaitable, a coroutine, asyncio.Future or anything else that can be awaited
+        Awaitable(PyObject* pLoop, PyObject* pAwaitable) noexcept
+            : m_pLoop(pLoop), m_pAwaitable(pAwaitable)
+        {}
+
+        ~Awaitable()
+        {
+            if (m_pAwaitable)
+                detail::ReleaseWithGIL(m_pAwaitable);
+        }
+
+        // the done callback points to this object while it is being awaited
+        Awaitable(const Awaitable& other) = delete;
+        Awaitable& operator=(const Awaitable& other) = delete;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            handle = awaiting;
+            return detail::ScheduleAwaitable(m_pLoop, std::exchange(m_pAwaitable, nullptr), this);
+        }
+
+        T await_resume()
+        {
+            if (exception)
+                std::rethrow_exception(exception);
+            if constexpr (!std::is_void_v<T>)
+                return std::move(*m_result);
+        }
+
+    private:
+        void SetResult(const Object& result) override
+        {
+            if constexpr (!std::is_void_v<T>)
+                m_result.emplace(python_cast<T>(result));
+        }
+
+        PyObject* m_pLoop;
+        PyObject* m_pAwaitable;
+        std::conditional_t<std::is_void_v<T>, std::nullopt_t, std::optional<T>> m_result{ std::nullopt };
+    };
+
+    class PYCPP_API EventLoop
+    {
+    public:
+        // Creates a new asyncio event loop and runs it on a dedicated thread
+        EventLoop();
+
+        // Cancels all remaining tasks, then stops and closes the loop
+        ~EventLoop();
+
+        EventLoop(const EventLoop& other) = delete;
+        EventLoop& operator=(const EventLoop& other) = delete;
+
+        // The asyncio event loop, e.g. to schedule callbacks with call_soon_threadsafe
+        [[nodiscard]] const Object& Loop() const noexcept { return m_loop; }
+
+        // co_await the result of a coroutine or future converted to T. Needs the GIL
+        template<typename T = void>
+        [[nodiscard]] Awaitable<T> Await(const Object& awaitable) const
+        {
+            Py_INCREF(awaitable.get());
+            return Awaitable<T>(m_loop.get(), awaitable.get());
+        }
+
+        // co_await the result of the async function fn called with args, converted to T. Acquires
+        // the GIL to start the call, so it can be used from a coroutine running on the loop thread
+        template<typename T = void, typename... Args>
+        [[nodiscard]] Awaitable<T> Call(const Callable& fn, const Args&... args) const
+        {
+            GILAcquire gil;
+            return Awaitable<T>(m_loop.get(), fn.Invoke(args...).ReleaseOwnership());
+        }
+
+    private:
+        void Run(std::promise<void>& started) noexcept;
+
+        InterpreterHandle m_handle;
+        Object m_loop;
+        std::thread m_thread;
+    };
+}
+
+#endif // PYCPP_ASYNC_H
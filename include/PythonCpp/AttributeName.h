@@ -0,0 +1,71 @@
+#pragma once
+#ifndef PYCPP_ATTRIBUTE_NAME_H
+#define PYCPP_ATTRIBUTE_NAME_H
+
+/*
+    Each interpreter keeps a cache of interned str objects for the names of bounded call sites:
+    AttributeName/PYCPP_NAME, MethodHandle, keyword argument names and record fields. A dict
+    lookup with an interned key usually ends at a pointer comparison. Names given as strings
+    (GetAttribute(const char*), CallFunction, ...) reuse a cached name if there is one and
+    otherwise create a temporary str, so names built at runtime do not grow the cache.
+
+    AttributeName remembers the interned object of a name known at compile time, so repeated
+    use only compares the interpreter key.
+
+        static const pycpp::AttributeName predict("predict");
+        model.GetAttribute(predict);
+
+    or, without declaring the static yourself:
+
+        model.GetAttribute(PYCPP_NAME("predict"));
+*/
+
+#include "Python.h"
+#include "Object.h"
+#include "Interpreter.h"
+#include <string_view>
+
+namespace pycpp
+{
+    namespace detail
+    {
+        // Borrowed interned str for name, cached for the lifetime of the current interpreter. Throws on
+        // failure. Every distinct name stays cached, so this is only meant for names from a bounded set
+        // (literals, record fields); use NameObject for names built at runtime
+        PYCPP_API PyObject* InternName(std::string_view name);
+
+        // str for name: the interned one if name is cached already, otherwise a new str that is not
+        // cached. Null with the Python error set on failure
+        PYCPP_API Object NameObject(std::string_view name) noexcept;
+
+        // Same as InternName but returns nullptr (with the Python error cleared) on failure
+        PYCPP_API PyObject* TryInternName(std::string_view name) noexcept;
+    }
+
+    class PYCPP_API AttributeName
+    {
+    public:
+        template<size_t N>
+        constexpr AttributeName(const char(&name)[N]) noexcept
+            : m_name(name, N - 1)
+        {}
+
+        [[nodiscard]] constexpr std::string_view View() const noexcept
+        {
+            return m_name;
+        }
+
+        // Borrowed interned str for the current interpreter
+        [[nodiscard]] PyObject* Get() const;
+
+    private:
+        std::string_view m_name;
+        detail::InterpreterLocalRef m_pyName;
+    };
+}
+
+// Static AttributeName for a string literal, created on first use at this call site
+#define PYCPP_NAME(literal) \
+    ([]() -> const ::pycpp::AttributeName& { static const ::pycpp::AttributeName s_name(literal); return s_name; }())
+
+#endif // PYCPP_ATTRIBUTE_NAME_H
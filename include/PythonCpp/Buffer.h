@@ -0,0 +1,341 @@
+#pragma once
+#ifndef PYCPP_BUFFER_H
+#define PYCPP_BUFFER_H
+
+/*
+    Buffer exposes contiguous C++ memory to Python through the buffer protocol without copying it.
+    Python code can wrap it in a memoryview, numpy.frombuffer, array etc. and will read the C++
+    memory directly. The element type determines the struct format code (e.g. 'd' for double), the
+    shape may have any number of dimensions and defaults to row-major (C order) strides.
+
+        std::vector<double> features = ...;
+        pycpp::Buffer buffer(features.data(), { rows, cols });
+        numpyFrombuffer(buffer);
+
+    Borrowed memory has to outlive every Python object using it. If that can not be guaranteed,
+    hand over the memory (move a vector into the Buffer, or pass an owner that keeps the memory
+    alive) so its lifetime is tied to the Python object instead. Borrowed memory is exported as
+    read-only.
+
+    The other direction is covered by BufferView<T>: it acquires the buffer of any Python object
+    supporting the protocol (bytes, bytearray, array.array, numpy arrays, ...) and exposes its
+    memory as std::span<const T> until the view is destroyed.
+
+        auto scores = pycpp::python_cast<pycpp::BufferView<double>>(model.Invoke(x));
+        std::accumulate(scores.begin(), scores.end(), 0.0);
+*/
+
+#include "Python.h"
+#include "Object.h"
+#include "Error.h"
+#include <complex>
+#include <cstdint>
+#include <initializer_list>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "TypeTraits.h"
+
+namespace pycpp
+{
+    namespace detail
+    {
+        // struct module format code for T, see https://docs.python.org/3/library/struct.html
+        template<typename T, typename U = void>
+        struct BufferFormat
+        {
+            static_assert(sizeof(T) == 0, "BufferFormat: Type not supported in buffers");
+        };
+
+        template<> struct BufferFormat<bool> { constexpr static const char* value = "?"; };
+        template<> struct BufferFormat<char> { constexpr static const char* value = "c"; };
+        template<> struct BufferFormat<signed char> { constexpr static const char* value = "b"; };
+        template<> struct BufferFormat<unsigned char> { constexpr static const char* value = "B"; };
+        template<> struct BufferFormat<std::byte> { constexpr static const char* value = "B"; };
+        template<> struct BufferFormat<short> { constexpr static const char* value = "h"; };
+        template<> struct BufferFormat<unsigned short> { constexpr static const char* value = "H"; };
+        template<> struct BufferFormat<int> { constexpr static const char* value = "i"; };
+        template<> struct BufferFormat<unsigned int> { constexpr static const char* value = "I"; };
+        template<> struct BufferFormat<long> { constexpr static const char* value = "l"; };
+        template<> struct BufferFormat<unsigned long> { constexpr static const char* value = "L"; };
+        template<> struct BufferFormat<long long> { constexpr static const char* value = "q"; };
+        template<> struct BufferFormat<unsigned long long> { constexpr static const char* value = "Q"; };
+        template<> struct BufferFormat<float> { constexpr static const char* value = "f"; };
+        template<> struct BufferFormat<double> { constexpr static const char* value = "d"; };
+        template<> struct BufferFormat<std::complex<float>> { constexpr static const char* value = "Zf"; };
+        template<> struct BufferFormat<std::complex<double>> { constexpr static const char* value = "Zd"; };
+
+        template<typename T>
+        constexpr auto BufferFormat_v = BufferFormat<std::remove_cv_t<T>>::value;
+
+        struct BufferInfo
+        {
+            const void* pData = nullptr;
+            Py_ssize_t itemSize = 0;
+            const char* format = nullptr; // always a string literal from BufferFormat
+            bool readOnly = true;
+            std::vector<Py_ssize_t> shape;
+            std::vector<Py_ssize_t> strides; // in bytes
+            std::shared_ptr<const void> owner;
+        };
+
+        // Creates the exporter object for info. Computes row-major strides if none are given
+        PYCPP_API Object MakeBufferExporter(BufferInfo info);
+
+        enum class BufferKind
+        {
+            Bool,
+            Char,
+            Signed,
+            Unsigned,
+            Float,
+            Complex
+        };
+
+        template<typename T>
+        constexpr BufferKind BufferKindOf() noexcept
+        {
+            using value_t = std::remove_cv_t<T>;
+            if constexpr (std::is_same_v<value_t, bool>)
+                return BufferKind::Bool;
+            else if constexpr (std::is_same_v<value_t, char> || std::is_same_v<value_t, std::byte>)
+                return BufferKind::Char;
+            else if constexpr (std::is_integral_v<value_t> && std::is_signed_v<value_t>)
+                return BufferKind::Signed;
+            else if constexpr (std::is_integral_v<value_t>)
+                return BufferKind::Unsigned;
+            else if constexpr (std::is_floating_point_v<value_t>)
+                return BufferKind::Float;
+            else
+            {
+                static_assert(BufferFormat<value_t>::value != nullptr);
+                return BufferKind::Complex;
+            }
+        }
+
+        // Throws if the format of view does not describe native items of the given kind and size.
+        // Equivalent codes of the same size are accepted, e.g. 'l' and 'q' on LP64 platforms
+        PYCPP_API void CheckBufferFormat(const Py_buffer& view, BufferKind kind, size_t itemSize);
+    }
+
+    class PYCPP_API Buffer : public Object
+    {
+    public:
+        // Read-only 1-D view of a contiguous container (std::vector, std::array, ...)
+        template<typename Container, typename val_t = std::remove_cv_t<std::remove_pointer_t<decltype(std::declval<const Container&>().data())>>>
+        explicit Buffer(const Container& container)
+            : Buffer(container.data(), { static_cast<Py_ssize_t>(container.size()) })
+        {}
+
+        // Takes over the vector, the memory lives as long as the Python object does and is writable
+        template<typename T>
+        explicit Buffer(std::vector<T>&& vec)
+        {
+            auto pOwner = std::make_shared<std::vector<T>>(std::move(vec));
+            detail::BufferInfo info;
+            info.pData = pOwner->data();
+            info.itemSize = sizeof(T);
+            info.format = detail::BufferFormat_v<T>;
+            info.readOnly = false;
+            info.shape = { static_cast<Py_ssize_t>(pOwner->size()) };
+            info.owner = std::move(pOwner);
+            Object::operator=(detail::MakeBufferExporter(std::move(info)));
+        }
+
+        // Read-only n-d view of borrowed memory. strides are given in bytes, row-major if omitted
+        template<typename T>
+        Buffer(const T* pData, std::vector<Py_ssize_t> shape, std::vector<Py_ssize_t> strides = {})
+            : Buffer(pData, std::move(shape), std::move(strides), nullptr)
+        {}
+
+        // Same as above, but owner is kept alive as long as the Python object lives
+        template<typename T>
+        Buffer(const T* pData, std::vector<Py_ssize_t> shape, std::vector<Py_ssize_t> strides, std::shared_ptr<const void> owner)
+        {
+            detail::BufferInfo info;
+            info.pData = pData;
+            info.itemSize = sizeof(T);
+            info.format = detail::BufferFormat_v<T>;
+            info.shape = std::move(shape);
+            info.strides = std::move(strides);
+            info.owner = std::move(owner);
+            Object::operator=(detail::MakeBufferExporter(std::move(info)));
+        }
+
+        Buffer(const Buffer& other);
+        Buffer& operator=(const Buffer& other);
+        Buffer(Buffer&& other) noexcept;
+        Buffer& operator=(Buffer&& other) noexcept;
+
+        // New memoryview of the buffer
+        [[nodiscard]] Object MemoryView() const;
+    };
+
+    /*
+        Read-only view of the memory of any object supporting the buffer protocol. The buffer
+        has to be C-contiguous and its format has to match T. The buffer is released (and the
+        object it belongs to decreffed) when the view is destroyed, so it must not outlive
+        the interpreter.
+    */
+    template<typename T>
+    class BufferView
+    {
+        static_assert(!std::is_reference_v<T>, "BufferView<T>: T must not be a reference");
+    public:
+        using value_type = T;
+        using const_iterator = typename std::span<const T>::iterator;
+
+        explicit BufferView(PyObject* pPyObj)
+        {
+            if (PyObject_GetBuffer(pPyObj, &m_view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) != 0)
+                Error::ThrowCurrent();
+            m_acquired = true;
+            try
+            {
+                detail::CheckBufferFormat(m_view, detail::BufferKindOf<T>(), sizeof(T));
+            }
+            catch (...)
+            {
+                // the destructor doesn't run for a throwing constructor
+                Release();
+                throw;
+            }
+        }
+
+        explicit BufferView(const Object& pyObj)
+            : BufferView(pyObj.get())
+        {}
+
+        BufferView(const BufferView& other) = delete;
+        BufferView& operator=(const BufferView& other) = delete;
+
+        BufferView(BufferView&& other) noexcept
+        {
+            TakeView(other);
+        }
+
+        BufferView& operator=(BufferView&& other) noexcept
+        {
+            if (this == &other)
+                return *this;
+            Release();
+            TakeView(other);
+            return *this;
+        }
+
+        ~BufferView()
+        {
+            Release();
+        }
+
+        // All items in row-major order
+        [[nodiscard]] std::span<const T> span() const noexcept
+        {
+            return { data(), size() };
+        }
+
+        [[nodiscard]] const T* data() const noexcept
+        {
+            return static_cast<const T*>(m_view.buf);
+        }
+
+        [[nodiscard]] size_t size() const noexcept
+        {
+            return static_cast<size_t>(m_view.len / m_view.itemsize);
+        }
+
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+            return span().begin();
+        }
+
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+            return span().end();
+        }
+
+        const T& operator[](size_t idx) const noexcept
+        {
+            return data()[idx];
+        }
+
+        [[nodiscard]] size_t ndim() const noexcept
+        {
+            return static_cast<size_t>(m_view.ndim);
+        }
+
+        // Extent per dimension
+        [[nodiscard]] std::span<const Py_ssize_t> shape() const noexcept
+        {
+            return { m_view.shape, ndim() };
+        }
+
+        // Strides in bytes per dimension
+        [[nodiscard]] std::span<const Py_ssize_t> strides() const noexcept
+        {
+            return { m_view.strides, ndim() };
+        }
+
+        // The object exporting the buffer
+        [[nodiscard]] Object Owner() const
+        {
+            return Object::BorrowedRef(m_view.obj);
+        }
+
+        void Release() noexcept
+        {
+            if (m_acquired)
+            {
+                PyBuffer_Release(&m_view);
+                m_acquired = false;
+            }
+        }
+
+    private:
+        void TakeView(BufferView& other) noexcept
+        {
+            m_view = other.m_view;
+            m_acquired = std::exchange(other.m_acquired, false);
+
+            // exporters using PyBuffer_FillInfo (bytes, bytearray, ...) point shape and strides
+            // into the Py_buffer itself, those have to point into the copy
+            const auto pBegin = reinterpret_cast<const std::byte*>(&other.m_view);
+            const auto pEnd = pBegin + sizeof(Py_buffer);
+            const auto rebase = [&](Py_ssize_t* pField) noexcept
+                {
+                    const auto pByte = reinterpret_cast<const std::byte*>(pField);
+                    if (std::less_equal<>()(pBegin, pByte) && std::less<>()(pByte, pEnd))
+                        return reinterpret_cast<Py_ssize_t*>(reinterpret_cast<std::byte*>(&m_view) + (pByte - pBegin));
+                    return pField;
+                };
+            m_view.shape = rebase(m_view.shape);
+            m_view.strides = rebase(m_view.strides);
+        }
+
+        Py_buffer m_view{};
+        bool m_acquired = false;
+    };
+
+    template<typename T>
+    struct isBufferView<BufferView<T>> : std::true_type
+    {};
+
+    template<typename T, std::enable_if_t<isBufferView_v<T>, int> = 0>
+    [[nodiscard]] T python_cast(const Object& pyObj)
+    {
+        return T(pyObj);
+    }
+
+    template<typename T, std::enable_if_t<isBufferView_v<T>, int> = 0>
+    [[nodiscard]] T python_cast(PyObject* pPyObj)
+    {
+        return T(pPyObj);
+    }
+}
+
+#endif // PYCPP_BUFFER_H
@@ -0,0 +1,182 @@
+#pragma once
+#ifndef PYCPP_BULK_CONVERSION_H
+#define PYCPP_BULK_CONVERSION_H
+
+/*
+    Conversion of whole homogeneous ranges between C++ and Python lists. Lists are allocated
+    with their final size and filled directly with new references (PyList_SET_ITEM steals
+    them), so there is no intermediate Object and no incref/decref pair per element.
+
+    The other direction first checks whether all items have the exact expected type (float,
+    or int small enough to be stored in a single digit). If so, the items are unboxed in a tight
+    loop without any error checks; otherwise every item goes through python_cast.
+*/
+
+#include "Python.h"
+#include "Object.h"
+#include "Error.h"
+#include "TypeTraits.h"
+#include "Arguments.h"
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace pycpp
+{
+    namespace detail
+    {
+        // New reference to the Python representation of val
+        template<typename T>
+        PyObject* NewReference(const T& val)
+        {
+            using Converter = ArgConverterFor<T>;
+            PyObject* pObject = Converter::Convert(val);
+            if constexpr (Converter::borrowed)
+                Py_INCREF(pObject);
+            return pObject;
+        }
+
+        // Takes over the reference of an Object that is not needed anymore instead of adding one
+        template<typename T, std::enable_if_t<std::is_base_of_v<Object, T> && !std::is_lvalue_reference_v<T>, int> = 0>
+        PyObject* NewReference(T&& obj)
+        {
+            if (!obj)
+                throw Error("Null Object passed as argument");
+            return obj.ReleaseOwnership();
+        }
+
+        // New tuple of the given values. The tuple steals the new references, so each item is
+        // referenced exactly once and temporaries are not increfed and decrefed again
+        template<typename... Args>
+        Object BuildTuple(Args&&... args)
+        {
+            Object tuple = PyTuple_New(static_cast<Py_ssize_t>(sizeof...(Args)));
+            if (!tuple)
+                Error::ThrowCurrent();
+            // if a conversion throws, tuple is released with the remaining slots still being null, which is fine
+            Py_ssize_t idx = 0;
+            const auto setItem = [&tuple, &idx](PyObject* pItem) noexcept { PyTuple_SET_ITEM(tuple.get(), idx++, pItem); };
+            (setItem(NewReference(std::forward<Args>(args))), ...);
+            return tuple;
+        }
+
+        // New list with the n elements starting at first
+        template<typename It>
+        Object BuildList(It first, size_t n)
+        {
+            Object list = PyList_New(static_cast<Py_ssize_t>(n));
+            if (!list)
+                Error::ThrowCurrent();
+            // if a conversion throws, list is released with the remaining slots still being null, which is fine
+            for (size_t idx = 0; idx < n; ++idx, ++first)
+                PyList_SET_ITEM(list.get(), static_cast<Py_ssize_t>(idx), NewReference(*first));
+            return list;
+        }
+
+#ifndef Py_LIMITED_API
+        // single digit ints always fit into integers of at least int size
+        template<typename T>
+        constexpr bool hasFastUnboxing = std::is_same_v<T, double> ||
+            (std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) >= sizeof(int));
+
+        // True if pItem can be unboxed to T by UnboxUnchecked
+        template<typename T>
+        bool IsFastUnboxable(PyObject* pItem) noexcept
+        {
+            if constexpr (std::is_same_v<T, double>)
+                return PyFloat_CheckExact(pItem);
+            else
+            {
+                if (!PyLong_CheckExact(pItem))
+                    return false;
+#if PY_VERSION_HEX >= 0x030C0000
+                const auto pLong = reinterpret_cast<PyLongObject*>(pItem);
+                if (!PyUnstable_Long_IsCompact(pLong))
+                    return false;
+                return std::is_signed_v<T> || PyUnstable_Long_CompactValue(pLong) >= 0;
+#else
+                const auto size = Py_SIZE(pItem);
+                return size <= 1 && (std::is_signed_v<T> ? size >= -1 : size >= 0);
+#endif
+            }
+        }
+
+        // Only valid if IsFastUnboxable<T>(pItem) is true
+        template<typename T>
+        T UnboxUnchecked(PyObject* pItem) noexcept
+        {
+            if constexpr (std::is_same_v<T, double>)
+                return PyFloat_AS_DOUBLE(pItem);
+            else
+            {
+#if PY_VERSION_HEX >= 0x030C0000
+                return static_cast<T>(PyUnstable_Long_CompactValue(reinterpret_cast<PyLongObject*>(pItem)));
+#else
+                return static_cast<T>(Py_SIZE(pItem) * static_cast<sdigit>(reinterpret_cast<PyLongObject*>(pItem)->ob_digit[0]));
+#endif
+            }
+        }
+
+        // Unboxes all n items into pOut if all of them are fast unboxable. Branch free per item
+        // once the types are checked, so the loop can be unrolled/vectorized by the compiler
+        template<typename T>
+        bool TryUnboxAll(PyObject* const* ppItems, size_t n, T* pOut) noexcept
+        {
+            bool allFast = true;
+            for (size_t idx = 0; idx < n; ++idx)
+                allFast &= IsFastUnboxable<T>(ppItems[idx]);
+            if (!allFast)
+                return false;
+
+            for (size_t idx = 0; idx < n; ++idx)
+                pOut[idx] = UnboxUnchecked<T>(ppItems[idx]);
+            return true;
+        }
+#else
+        template<typename T>
+        constexpr bool hasFastUnboxing = false;
+#endif //Py_LIMITED_API
+
+        // Converts a single item to T, unboxing it directly if it has the exact expected type
+        template<typename T>
+        T UnboxItem(PyObject* pItem)
+        {
+            static_assert(!isStringView_v<T>, "UnboxItem: std::string_view would point into a temporary object, use std::string");
+            if constexpr (hasFastUnboxing<T>)
+            {
+                if (IsFastUnboxable<T>(pItem))
+                    return UnboxUnchecked<T>(pItem);
+            }
+            return python_cast<T>(pItem);
+        }
+
+        // Converts all items of a Python list into out
+        template<typename T>
+        void ListToVector(PyObject* pList, std::vector<T>& out)
+        {
+            static_assert(!isStringView_v<T>, "ListToVector: std::string_view would point into a temporary object, use std::string");
+            const auto n = static_cast<size_t>(PyList_Size(pList));
+            out.clear();
+            if constexpr (hasFastUnboxing<T>)
+            {
+                // python_cast can run arbitrary Python code which may modify the list, so only the
+                // fast path works on the item array directly
+                out.resize(n);
+                if (TryUnboxAll(PySequence_Fast_ITEMS(pList), n, out.data()))
+                    return;
+                out.clear();
+            }
+            out.reserve(n);
+            for (Py_ssize_t idx = 0; idx < PyList_Size(pList); ++idx)
+            {
+                // hold the item, the conversion might remove it from the list
+                const Object item = Object::BorrowedRef(PyList_GetItem(pList, idx));
+                if (!item)
+                    Error::ThrowCurrent();
+                out.push_back(python_cast<T>(item.get()));
+            }
+        }
+    }
+}
+
+#endif // PYCPP_BULK_CONVERSION_H
@@ -0,0 +1,87 @@
+#pragma once
+#ifndef PYCPP_BYTES_H
+#define PYCPP_BYTES_H
+
+/*
+    Bytes wraps a Python bytes object. Its contents are read in place as std::span<const std::byte>
+    (or std::string_view), nothing is copied out:
+
+        auto payload = pycpp::python_cast<pycpp::Bytes>(fn.Invoke());
+        Parse(payload.View());
+
+    Payloads produced in C++ can be written straight into a new bytes object, so the data is only
+    copied once (by the code producing it) instead of into a temporary buffer first:
+
+        pycpp::Bytes payload(message.ByteSizeLong(), [&](std::span<std::byte> out)
+            {
+                message.SerializeToArray(out.data(), static_cast<int>(out.size()));
+            });
+
+    Views are only valid as long as the Bytes (or another reference to the object) is alive.
+*/
+
+#include "Python.h"
+#include "Defines.h"
+#include "Object.h"
+#include "Error.h"
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+namespace pycpp
+{
+    class PYCPP_API Bytes : public Object
+    {
+    public:
+        // Empty bytes, analog to b"" in Python
+        Bytes();
+
+        explicit Bytes(std::span<const std::byte> data);
+
+        explicit Bytes(std::string_view data);
+
+        // Allocates size bytes and lets fill write them in place. fill has to write all of them,
+        // the memory is not initialized
+        template<typename Fill, std::enable_if_t<std::is_invocable_v<Fill, std::span<std::byte>>, int> = 0>
+        Bytes(size_t size, Fill&& fill)
+            : Object(PyBytes_FromStringAndSize(nullptr, static_cast<Py_ssize_t>(size)))
+        {
+            if (!m_pObject)
+                Error::ThrowCurrent();
+            fill(std::span<std::byte>(MutableData(), size));
+        }
+
+        // Take ownership of an existing PyObject which points to a Python bytes or subtype of bytes
+        // Will throw Error if object pointed to by PyObject* is not of bytes type
+        Bytes(PyObject* pBytesObj);
+
+        Bytes(const Bytes& other);
+
+        Bytes& operator=(const Bytes& other);
+
+        Bytes(Bytes&& other) noexcept;
+
+        Bytes& operator=(Bytes&& other) noexcept;
+
+        Bytes(const Object& other);
+
+        Bytes& operator=(const Object& other);
+
+        // Note: No move construction/assignment from Object, because due to the PyBytes_Check
+        // they cannot be defined noexcept!
+
+        [[nodiscard]] size_t size() const noexcept;
+
+        [[nodiscard]] const std::byte* data() const noexcept;
+
+        [[nodiscard]] std::span<const std::byte> View() const noexcept;
+
+        [[nodiscard]] std::string_view StringView() const noexcept;
+
+    private:
+        std::byte* MutableData() const noexcept;
+    };
+}
+
+#endif // PYCPP_BYTES_H
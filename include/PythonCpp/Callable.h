@@ -1,193 +1,34 @@
 #pragma once
 #include "Utilities.h"
+#include "Arguments.h"
+#include "Result.h"
+#include "BulkConversion.h"
+#include <iterator>
+#include <string>
+#include <vector>
 
 namespace pycpp
 {
-    template<typename... Args>
-    Object BuildValue(const char* format, Args... args)
-    {
-        Object ret = Py_BuildValue(format, args...);
-        if (!ret)
-            throw Error();
-        return ret;
-    }
-
     PYCPP_API Object CallObject(PyObject* pCallableObject, PyObject* pArglist);
     PYCPP_API Object CallObject(const Object& callableObject, PyObject* pArglist);
     PYCPP_API Object CallObject(PyObject* pCallableObject, const Object& arglist);
     PYCPP_API Object CallObject(const Object& callableObject, const Object& arglist);
 
-    namespace detail
-    {
-        template<typename T, typename U = void>
-        struct ArgRepr
-        {
-            
-        };
-
-        // TODO special case for bool
-
-        template<typename CharT>
-        struct ArgRepr<std::basic_string<CharT>>
-        {
-            constexpr static auto value = ArgRepr<const CharT*>::value;
-        };
-
-        template<>
-        struct ArgRepr<const char*>
-        {
-            constexpr static auto value = 's';
-        };
-
-        template<>
-        struct ArgRepr<const wchar_t*>
-        {
-            constexpr static auto value = 'u';
-        };
-
-        template<>
-        struct ArgRepr<int>
-        {
-            constexpr static auto value = 'i';
-        };
-
-        template<>
-        struct ArgRepr<char>
-        {
-            constexpr static auto value = 'b';
-        };
-
-        template<>
-        struct ArgRepr<short>
-        {
-            constexpr static auto value = 'h';
-        };
-
-        template<>
-        struct ArgRepr<long>
-        {
-            constexpr static auto value = 'l';
-        };
-
-        template<>
-        struct ArgRepr<unsigned int>
-        {
-            constexpr static auto value = 'I';
-        };
-
-        template<>
-        struct ArgRepr<unsigned char>
-        {
-            constexpr static auto value = 'B';
-        };
-
-        template<>
-        struct ArgRepr<unsigned short>
-        {
-            constexpr static auto value = 'H';
-        };
-
-        template<>
-        struct ArgRepr<unsigned long>
-        {
-            constexpr static auto value = 'k';
-        };
-
-        template<>
-        struct ArgRepr<long long>
-        {
-            constexpr static auto value = 'L';
-        };
-
-        template<>
-        struct ArgRepr<unsigned long long>
-        {
-            constexpr static auto value = 'K';
-        };
-
-        template<>
-        struct ArgRepr<float>
-        {
-            constexpr static auto value = 'f';
-        };
-
-        template<>
-        struct ArgRepr<double>
-        {
-            constexpr static auto value = 'd';
-        };
-
-        template<>
-        struct ArgRepr<Object>
-        {
-            constexpr static auto value = 'O';
-        };
-
-        template<typename T>
-        struct ArgRepr<T, typename std::enable_if_t<std::is_base_of_v<Object, T>>>
-        {
-            constexpr static auto value = 'O';
-        };
-
-        template<>
-        struct ArgRepr<PyObject*>
-        {
-            constexpr static auto value = 'O';
-        };
-
-        template<typename... Args>
-        struct ArgFormatString
-        {
-            constexpr static char value[] = { '(', ArgRepr<Args>::value ..., ')', '\0' };
-        };
-
-        template<typename T, bool isPyObj = false>
-        struct BuildTypeBase
-        {
-            using type = const T&;
-        };
-
-        template<typename T>
-        struct BuildTypeBase<T, true>
-        {
-            using type = PyObject*;
-        };
-
-        template<typename T>
-        struct BuildType : BuildTypeBase<T, std::is_base_of_v<Object, T>>
-        {};
+    // Calls pCallableObject with the positional arguments in ppArgs using the vectorcall protocol.
+    // nargsf may have PY_VECTORCALL_ARGUMENTS_OFFSET set, see detail::VectorcallArgs
+    PYCPP_API Object VectorcallObject(PyObject* pCallableObject, PyObject* const* ppArgs, size_t nargsf, PyObject* pKwnames = nullptr);
 
-        template<typename CharT>
-        struct BuildType<std::basic_string<CharT>>
-        {
-            using type = const CharT*;
-        };
+    // Calls the method pName of ppArgs[0] with the remaining arguments, without creating a bound method object
+    PYCPP_API Object VectorcallMethod(PyObject* pName, PyObject* const* ppArgs, size_t nargsf, PyObject* pKwnames = nullptr);
 
-        template<typename T, std::enable_if_t<!std::is_base_of_v<Object, T>, int> = 0>
-        typename BuildType<T>::type PrepareForBuild(const T& value)
-        {
-            return value;
-        }
-
-        template<typename T, std::enable_if_t<std::is_base_of_v<Object, T>, int> = 0>
-        typename BuildType<T>::type PrepareForBuild(const T& pyObj)
-        {
-            return pyObj.get();
-        }
-
-        template<typename CharT>
-        typename BuildType<std::basic_string<CharT>>::type PrepareForBuild(const std::basic_string<CharT>& str)
-        {
-            return str.c_str();
-        }
-        
-
-        template<typename... Args>
-        Object BuildArgList(const Args&... args)
-        {
-            return BuildValue(ArgFormatString<Args...>::value, PrepareForBuild(args)...);
-        }
-    }
+    // How Callable::Map passes the inputs to the callable
+    enum class MapMode
+    {
+        // one call per input
+        PerElement,
+        // one call with a list of all inputs, which has to return a sequence of the same length
+        Batch
+    };
 
     /* Callable represents a highlevel abstraction to any Object which is callable
     *  meaning that callable(object) in Python evaluates to True. A Callable can not be
@@ -219,11 +60,32 @@ namespace pycpp
         // Note: No move construction/assignment from Object, because due to the PyCallable_Check
         // they cannot be defined noexcept!
 
-        // Args can be of type Object or of any type which is convertible to Object
+        // Args can be of type Object or of any type which is convertible to Object.
+        // Arguments are converted into a stack array and passed via vectorcall, so no
+        // argument tuple is allocated for the call. Keyword arguments can be passed as
+        // last argument, see Keywords
         template<typename... Args>
         Object Invoke(const Args&... args) const
         {
-            return CallObject(m_pObject, detail::BuildArgList(args...));
+            return TryInvoke(args...).value();
+        }
+
+        // Same as Invoke, but failures (including Python exceptions raised by the call) are returned
+        // instead of thrown, see Result.h
+        template<typename... Args>
+        [[nodiscard]] Result<Object> TryInvoke(const Args&... args) const
+        {
+            // only converting the arguments can throw
+            return detail::CatchErrors<Object>([&]() -> Result<Object>
+                {
+                    return detail::WithVectorcallArgs([this](const auto& argArray, size_t nargsf, PyObject* pKwnames) -> Result<Object>
+                        {
+                            Object result = PyObject_Vectorcall(m_pObject, argArray.data(), nargsf, pKwnames);
+                            if (!result)
+                                return ErrorInfo::Fetch();
+                            return result;
+                        }, args...);
+                });
         }
 
         template<typename... Args>
@@ -231,22 +93,115 @@ namespace pycpp
         {
             return Invoke(args...);
         }
+
+        // Calls the callable with every element of inputs and converts the results to T. The inputs
+        // are converted to Python in one go, the argument array is reused for all calls and exact
+        // float/int results are unboxed directly (see BulkConversion.h). With MapMode::Batch the
+        // callable is called only once with a list of all inputs, for functions vectorized in Python
+        template<typename T, typename Container>
+        std::vector<T> Map(const Container& inputs, MapMode mode = MapMode::PerElement) const
+        {
+            std::vector<T> out;
+            MapInto(inputs, out, mode);
+            return out;
+        }
+
+        // Same as Map, but reuses the memory of out
+        template<typename Container, typename T>
+        void MapInto(const Container& inputs, std::vector<T>& out, MapMode mode = MapMode::PerElement) const
+        {
+            const auto n = static_cast<size_t>(std::size(inputs));
+            const Object arguments = detail::BuildList(std::begin(inputs), n);
+            out.clear();
+
+            if (mode == MapMode::Batch)
+            {
+                Object results = Invoke(arguments);
+                if (!PyList_Check(results.get()))
+                {
+                    results = PySequence_List(results.get());
+                    if (!results)
+                        Error::ThrowCurrent();
+                }
+                const auto resultCount = static_cast<size_t>(PyList_GET_SIZE(results.get()));
+                if (resultCount != n)
+                    throw Error("Callable::Map: batch call returned " + std::to_string(resultCount) + " results for " + std::to_string(n) + " inputs");
+                detail::ListToVector(results.get(), out);
+                return;
+            }
+
+            out.reserve(n);
+            // the first slot is scratch space for the callee, see PY_VECTORCALL_ARGUMENTS_OFFSET
+            PyObject* argArray[2] = { nullptr, nullptr };
+            for (size_t idx = 0; idx < n; ++idx)
+            {
+                argArray[1] = PyList_GET_ITEM(arguments.get(), static_cast<Py_ssize_t>(idx));
+                const Object result = VectorcallObject(m_pObject, argArray + 1, 1 | PY_VECTORCALL_ARGUMENTS_OFFSET);
+                out.push_back(detail::UnboxItem<T>(result.get()));
+            }
+        }
     private:
 
     };
 
-    // Shortcut function for calling a function or method which is owned by owningObject with args functionArgs
-    template<typename... Args>
-    Object CallFunction(const Object& owningObject, const char* functionName, const Args&... functionArgs)
+    namespace detail
     {
-        const Callable methodObj = GetAttributeString(owningObject, functionName);
-
-        return methodObj(functionArgs...);
+        // Calls the method pName (a str) of self with args, see MethodHandle
+        template<typename... Args>
+        Object InvokeMethod(PyObject* pName, const Object& self, const Args&... args)
+        {
+            PyObject* pSelf = ArgConverter<Object>::Convert(self);
+            return WithVectorcallArgs([&](auto& argArray, size_t nargsf, PyObject* pKwnames)
+                {
+                    // self takes the place of the scratch slot, so the offset flag must not be set
+                    return VectorcallMethod(pName, argArray.dataWithSelf(pSelf), PyVectorcall_NARGS(nargsf) + 1, pKwnames);
+                }, args...);
+        }
     }
 
+    /*
+        MethodHandle calls a method by name on any object, e.g. obj.predict(x), via PyObject_VectorcallMethod.
+        The interned name is created once per interpreter and no bound method object is created for the call,
+        so keeping a handle around (e.g. as a static) is the cheapest way to call the same method repeatedly.
+    */
+    class PYCPP_API MethodHandle
+    {
+    public:
+        explicit MethodHandle(std::string methodName);
+
+        [[nodiscard]] const std::string& MethodName() const noexcept;
+
+        // Borrowed interned name object for the current interpreter
+        [[nodiscard]] PyObject* Name() const;
+
+        // Args can be of type Object or of any type which is convertible to Object
+        // Keyword arguments can be passed as last argument, see Keywords
+        template<typename... Args>
+        Object Invoke(const Object& self, const Args&... args) const
+        {
+            return detail::InvokeMethod(Name(), self, args...);
+        }
+
+        template<typename... Args>
+        Object operator()(const Object& self, const Args&... args) const
+        {
+            return Invoke(self, args...);
+        }
+
+    private:
+        std::string m_methodName;
+        detail::InterpreterLocalRef m_name;
+    };
+
+    // Shortcut function for calling a function or method which is owned by owningObject with args functionArgs
+    // The name is not cached (see detail::NameObject), so names may be built at runtime. If the same
+    // method is called repeatedly, prefer a MethodHandle
     template<typename... Args>
-    Object CallFunction(const Object& owningObject, const std::string& functionName, const Args&... functionArgs)
+    Object CallFunction(const Object& owningObject, std::string_view functionName, const Args&... functionArgs)
     {
-        return CallFunction(owningObject, functionName.c_str(), functionArgs...);
+        const auto name = detail::NameObject(functionName);
+        if (!name)
+            Error::ThrowCurrent();
+        return detail::InvokeMethod(name.get(), owningObject, functionArgs...);
     }
 }
@@ -0,0 +1,349 @@
+#pragma once
+#ifndef PYCPP_CLASS_H
+#define PYCPP_CLASS_H
+
+/*
+    Class exposes a C++ class to Python as a native heap type (PyType_FromSpec). The C++ object is
+    stored inline in the Python object, so an instance takes a single allocation, and Python code
+    works on the C++ state in place instead of on a copy:
+
+        pycpp::Class<FeatureStore>("features.FeatureStore")
+            .Constructor<size_t>()
+            .Method<&FeatureStore::Lookup>("lookup")
+            .Method<&FeatureStore::Insert>("insert")
+            .Property<&FeatureStore::Size>("size")
+            .Property<&FeatureStore::hits>("hits");
+
+        // hands a long-lived store to Python, its contents are moved, not serialized
+        plugin.Invoke(pycpp::Class<FeatureStore>::New(std::move(store)));
+
+    Methods are member functions or functions taking T& (or const T&) as first parameter. They are
+    METH_FASTCALL methods generated per method at compile time, with the arguments and the result
+    converted as for Function (see Function.h), including the translation of exceptions.
+    Properties are data members (writable unless they are const) or getter member functions with
+    an optional setter. Python can only create instances if a Constructor is defined.
+
+    A C++ class is defined once and its definition has to be complete before the type is first
+    used (Type, New or Get); the type itself is created once per interpreter. The type can't be
+    subclassed in Python and its instances are not tracked by the cycle GC, so C++ objects holding
+    Objects must not be part of reference cycles.
+*/
+
+#include "Python.h"
+#include "Defines.h"
+#include "Object.h"
+#include "Error.h"
+#include "Interpreter.h"
+#include "Function.h"
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pycpp
+{
+    namespace detail
+    {
+        // Python object holding a T inline
+        template<typename T>
+        struct InstanceObject
+        {
+            PyObject_HEAD
+            bool constructed;
+            alignas(T) std::byte storage[sizeof(T)];
+        };
+
+        template<typename T>
+        T& InstanceOf(PyObject* pInstance) noexcept
+        {
+            return *std::launder(reinterpret_cast<T*>(reinterpret_cast<InstanceObject<T>*>(pInstance)->storage));
+        }
+
+        // Parameter (without the object) and result types of a method
+        template<typename M>
+        struct MethodSignature;
+
+        template<typename C, typename R, typename... Args>
+        struct MethodSignature<R(C::*)(Args...)>
+        {
+            using result = R;
+            using arguments = std::tuple<Args...>;
+        };
+
+        template<typename C, typename R, typename... Args>
+        struct MethodSignature<R(C::*)(Args...) const> : MethodSignature<R(C::*)(Args...)>
+        {};
+
+        template<typename C, typename R, typename... Args>
+        struct MethodSignature<R(C::*)(Args...) noexcept> : MethodSignature<R(C::*)(Args...)>
+        {};
+
+        template<typename C, typename R, typename... Args>
+        struct MethodSignature<R(C::*)(Args...) const noexcept> : MethodSignature<R(C::*)(Args...)>
+        {};
+
+        template<typename R, typename Self, typename... Args>
+        struct MethodSignature<R(*)(Self, Args...)>
+        {
+            using result = R;
+            using arguments = std::tuple<Args...>;
+        };
+
+        template<typename R, typename Self, typename... Args>
+        struct MethodSignature<R(*)(Self, Args...) noexcept> : MethodSignature<R(*)(Self, Args...)>
+        {};
+
+        template<typename T, auto member, typename = void>
+        struct isWritableMember : std::false_type
+        {};
+
+        template<typename T, auto member>
+        struct isWritableMember<T, member, std::enable_if_t<std::is_member_object_pointer_v<decltype(member)>>>
+            : std::bool_constant<!std::is_const_v<std::remove_reference_t<decltype(std::declval<T&>().*member)>>>
+        {};
+
+        using FastcallMethod = PyObject* (*)(PyObject*, PyObject* const*, Py_ssize_t);
+
+        // Non-template part of a class definition, shared by all interpreters
+        class PYCPP_API ClassSpec
+        {
+        public:
+            ClassSpec(std::string name, std::string doc, size_t basicSize, destructor dealloc);
+
+            ClassSpec(const ClassSpec& other) = delete;
+            ClassSpec& operator=(const ClassSpec& other) = delete;
+
+            void AddMethod(const char* pName, FastcallMethod method, const char* pDoc);
+
+            void AddProperty(const char* pName, getter get, setter set, const char* pDoc);
+
+            void SetConstructor(newfunc constructor);
+
+            // Borrowed, created on first use in every interpreter. The definition can't be changed anymore afterwards
+            [[nodiscard]] PyTypeObject* Type() const;
+
+            [[nodiscard]] bool IsInUse() const noexcept;
+
+        private:
+            void CheckNotInUse() const;
+            const char* Store(const char* pString);
+
+            std::string m_name;
+            std::string m_doc;
+            int m_basicSize;
+            destructor m_dealloc;
+            newfunc m_constructor;
+            std::deque<std::string> m_strings; // referenced by the method and property definitions
+            mutable std::vector<PyMethodDef> m_methods;
+            mutable std::vector<PyGetSetDef> m_properties;
+            mutable std::once_flag m_frozen;
+            mutable std::atomic<bool> m_inUse = false;
+            InterpreterLocalRef m_type;
+        };
+
+        // Raise the Python error and return nullptr or -1, for the functions below
+        PYCPP_API PyObject* ArgumentCountError(PyObject* pSelf, Py_ssize_t expected, Py_ssize_t given) noexcept;
+        PYCPP_API int DeleteAttributeError() noexcept;
+        PYCPP_API bool CheckConstructorArguments(PyTypeObject* pType, PyObject* pArgs, PyObject* pKwargs, Py_ssize_t expected) noexcept;
+
+        // Frees an instance after its C++ object has been destroyed
+        PYCPP_API void FreeInstance(PyObject* pInstance) noexcept;
+
+        template<typename T>
+        std::unique_ptr<ClassSpec>& ClassSpecOf() noexcept
+        {
+            static std::unique_ptr<ClassSpec> s_pSpec;
+            return s_pSpec;
+        }
+
+        template<typename T>
+        void DeallocInstance(PyObject* pInstance) noexcept
+        {
+            if (reinterpret_cast<InstanceObject<T>*>(pInstance)->constructed)
+                InstanceOf<T>(pInstance).~T();
+            FreeInstance(pInstance);
+        }
+
+        template<typename T, typename... Args>
+        Object EmplaceInstance(PyTypeObject* pType, Args&&... args)
+        {
+            Object instance = pType->tp_alloc(pType, 0);
+            if (!instance)
+                Error::ThrowCurrent();
+            auto* pInstance = reinterpret_cast<InstanceObject<T>*>(instance.get());
+            new (pInstance->storage) T(std::forward<Args>(args)...);
+            pInstance->constructed = true;
+            return instance;
+        }
+
+        template<typename T, typename... Args>
+        PyObject* NewInstance(PyTypeObject* pType, PyObject* pArgs, PyObject* pKwargs) noexcept
+        {
+            if (!CheckConstructorArguments(pType, pArgs, pKwargs, sizeof...(Args)))
+                return nullptr;
+            try
+            {
+                return InvokeConverted<Object, std::tuple<Args...>>([pType](auto&&... args)
+                    {
+                        return EmplaceInstance<T>(pType, std::forward<decltype(args)>(args)...);
+                    }, PySequence_Fast_ITEMS(pArgs));
+            }
+            catch (...)
+            {
+                SetCurrentException();
+                return nullptr;
+            }
+        }
+
+        template<typename T, auto method>
+        PyObject* CallMethod(PyObject* pSelf, PyObject* const* ppArgs, Py_ssize_t nargs) noexcept
+        {
+            using Signature = MethodSignature<decltype(method)>;
+            using Arguments = typename Signature::arguments;
+            if (nargs != static_cast<Py_ssize_t>(std::tuple_size_v<Arguments>))
+                return ArgumentCountError(pSelf, std::tuple_size_v<Arguments>, nargs);
+            try
+            {
+                auto& self = InstanceOf<T>(pSelf);
+                return InvokeConverted<typename Signature::result, Arguments>([&self](auto&&... args) -> decltype(auto)
+                    {
+                        return std::invoke(method, self, std::forward<decltype(args)>(args)...);
+                    }, ppArgs);
+            }
+            catch (...)
+            {
+                SetCurrentException();
+                return nullptr;
+            }
+        }
+
+        template<typename T, auto get>
+        PyObject* GetProperty(PyObject* pSelf, void*) noexcept
+        {
+            try
+            {
+                auto& self = InstanceOf<T>(pSelf);
+                using R = decltype(std::invoke(get, self));
+                return InvokeConverted<R, std::tuple<>>([&self]() -> decltype(auto) { return std::invoke(get, self); }, nullptr);
+            }
+            catch (...)
+            {
+                SetCurrentException();
+                return nullptr;
+            }
+        }
+
+        template<typename T, auto get, auto set>
+        int SetProperty(PyObject* pSelf, PyObject* pValue, void*) noexcept
+        {
+            if (!pValue)
+                return DeleteAttributeError();
+            try
+            {
+                auto& self = InstanceOf<T>(pSelf);
+                if constexpr (std::is_null_pointer_v<decltype(set)>)
+                    self.*get = ConvertArgument<ArgumentValue<decltype(self.*get)>>(pValue);
+                else
+                {
+                    using Value = std::tuple_element_t<0, typename MethodSignature<decltype(set)>::arguments>;
+                    std::invoke(set, self, ConvertArgument<ArgumentValue<Value>>(pValue));
+                }
+                return 0;
+            }
+            catch (...)
+            {
+                SetCurrentException();
+                return -1;
+            }
+        }
+    }
+
+    template<typename T>
+    class Class
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Class: over-aligned types can't be stored in Python objects");
+
+    public:
+        // name is the qualified name of the type (e.g. "features.FeatureStore"), doc its optional __doc__
+        explicit Class(std::string name, std::string doc = {})
+        {
+            auto& pSpec = detail::ClassSpecOf<T>();
+            if (pSpec && pSpec->IsInUse())
+                throw Error("Class: " + name + " is already in use and can't be defined again");
+            pSpec = std::make_unique<detail::ClassSpec>(std::move(name), std::move(doc), sizeof(detail::InstanceObject<T>), &detail::DeallocInstance<T>);
+        }
+
+        // Lets Python create instances, converting the arguments to Args
+        template<typename... Args>
+        Class& Constructor()
+        {
+            static_assert(std::is_constructible_v<T, Args...>, "Class: T is not constructible from Args");
+            Spec().SetConstructor(&detail::NewInstance<T, Args...>);
+            return *this;
+        }
+
+        template<auto method>
+        Class& Method(const char* pName, const char* pDoc = nullptr)
+        {
+            Spec().AddMethod(pName, &detail::CallMethod<T, method>, pDoc);
+            return *this;
+        }
+
+        // get is a data member or a getter, set an optional setter taking the new value
+        template<auto get, auto set = nullptr>
+        Class& Property(const char* pName, const char* pDoc = nullptr)
+        {
+            if constexpr (!std::is_null_pointer_v<decltype(set)> || detail::isWritableMember<T, get>::value)
+                Spec().AddProperty(pName, &detail::GetProperty<T, get>, &detail::SetProperty<T, get, set>, pDoc);
+            else
+                Spec().AddProperty(pName, &detail::GetProperty<T, get>, nullptr, pDoc);
+            return *this;
+        }
+
+        // The type in the current interpreter
+        static Object Type()
+        {
+            return Object::BorrowedRef(reinterpret_cast<PyObject*>(Spec().Type()));
+        }
+
+        // New instance holding a T constructed from args
+        template<typename... Args>
+        static Object New(Args&&... args)
+        {
+            return detail::EmplaceInstance<T>(Spec().Type(), std::forward<Args>(args)...);
+        }
+
+        [[nodiscard]] static bool Check(const Object& object)
+        {
+            return object && PyObject_TypeCheck(object.get(), Spec().Type()) != 0;
+        }
+
+        // The C++ object of an instance, valid as long as the instance is alive. Throws TypeError
+        // for other objects
+        [[nodiscard]] static T& Get(const Object& instance)
+        {
+            if (!Check(instance))
+                throw TypeError("Class: object is not an instance of the bound C++ class");
+            return detail::InstanceOf<T>(instance.get());
+        }
+
+    private:
+        static detail::ClassSpec& Spec()
+        {
+            auto& pSpec = detail::ClassSpecOf<T>();
+            if (!pSpec)
+                throw Error("Class: the C++ class has not been defined");
+            return *pSpec;
+        }
+    };
+}
+
+#endif // PYCPP_CLASS_H
@@ -0,0 +1,323 @@
+#pragma once
+#ifndef PYCPP_COLUMNS_H
+#define PYCPP_COLUMNS_H
+
+/*
+    Columnar export of records (see Record.h) for analytics code on the Python side. Instead of
+    one Python object per row, every field becomes one column: a dict maps the field names to
+    read-only Buffers, which numpy, pandas or pyarrow wrap without copying or boxing any row.
+
+        std::vector<Trade> trades = ...; // PYCPP_RECORD(Trade, symbol, price, quantity)
+        analyze(pycpp::ToColumns(trades));
+
+    where analyze could start with prices = numpy.frombuffer(columns["price"]).
+
+    ToColumns copies each field of a vector of rows into a contiguous column once. Data that is
+    already stored as a struct of vectors is shared instead: ShareColumns takes over the struct
+    and the columns point into its vectors, which live as long as any column does.
+
+        struct TradeColumns
+        {
+            std::vector<double> price;
+            std::vector<long> quantity;
+        };
+        PYCPP_RECORD(TradeColumns, price, quantity)
+
+        auto columns = pycpp::ShareColumns(std::move(tradeColumns));
+
+    Fields of arithmetic and complex type become 1-D Buffers of that type. Strings become a tuple
+    (offsets, data) in the layout of Arrow's large_string: data holds the UTF-8 bytes of all
+    strings back to back ('B'), offsets holds n + 1 int64 positions into data, so string i is
+    data[offsets[i]:offsets[i + 1]]. String columns are always copied into that layout.
+
+    Column names are the interned field names of the record.
+
+    ExtractColumns goes the other way: it walks a sequence of Python objects (dataclasses,
+    __slots__ classes, namedtuples, ...) once and appends the attribute named after each field
+    to the vectors of a struct of vectors:
+
+        auto trades = pycpp::ExtractColumns<TradeColumns>(fn.Invoke());
+
+    How an attribute is read is resolved once per type. __slots__ are read straight from their
+    offset in the object, other attributes go through the regular lookup with the interned
+    name. Exact floats and small ints are unboxed directly, see BulkConversion.h.
+*/
+
+#include "Python.h"
+#include "Object.h"
+#include "Error.h"
+#include "AttributeName.h"
+#include "Buffer.h"
+#include "BulkConversion.h"
+#include "Dict.h"
+#include "Record.h"
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pycpp
+{
+    namespace detail
+    {
+        template<typename T>
+        constexpr bool isColumnItem = std::is_arithmetic_v<T> || std::is_same_v<T, std::byte> ||
+            std::is_same_v<T, std::complex<float>> || std::is_same_v<T, std::complex<double>>;
+
+        template<typename T>
+        constexpr bool isStringColumnItem = std::is_convertible_v<const T&, std::string_view>;
+
+        template<typename T>
+        struct isVectorColumn : std::false_type
+        {};
+
+        template<typename T>
+        struct isVectorColumn<std::vector<T>> : std::bool_constant<isColumnItem<T> || isStringColumnItem<T>>
+        {};
+
+        template<typename Columns>
+        constexpr bool AreVectorColumns()
+        {
+            return std::apply([](auto... members)
+                {
+                    return (isVectorColumn<std::remove_cv_t<std::remove_reference_t<decltype(std::declval<const Columns&>().*members)>>>::value && ...);
+                }, RecordTraits<Columns>::fields);
+        }
+
+        template<typename T>
+        struct isViewColumn : std::false_type
+        {};
+
+        template<typename T>
+        struct isViewColumn<std::vector<T>> : std::bool_constant<isStringView_v<T>>
+        {};
+
+        // views can be shared with Python, but not extracted from the temporary attributes
+        template<typename Columns>
+        constexpr bool HasViewColumns()
+        {
+            return std::apply([](auto... members)
+                {
+                    return (isViewColumn<std::remove_cv_t<std::remove_reference_t<decltype(std::declval<const Columns&>().*members)>>>::value || ...);
+                }, RecordTraits<Columns>::fields);
+        }
+
+        // Column of n items written by get(idx), in memory owned by the Python object
+        template<typename T, typename Get>
+        Object GatherColumn(size_t n, Get&& get)
+        {
+            auto pItems = std::make_shared_for_overwrite<T[]>(n);
+            for (size_t idx = 0; idx < n; ++idx)
+                pItems[idx] = get(idx);
+            const T* pData = pItems.get();
+            return Buffer(pData, { static_cast<Py_ssize_t>(n) }, {}, std::move(pItems));
+        }
+
+        // (offsets, data) column of the n strings returned by get(idx), see above
+        template<typename Get>
+        Object StringColumn(size_t n, Get&& get)
+        {
+            auto pOffsets = std::make_shared_for_overwrite<int64_t[]>(n + 1);
+            pOffsets[0] = 0;
+            for (size_t idx = 0; idx < n; ++idx)
+                pOffsets[idx + 1] = pOffsets[idx] + static_cast<int64_t>(std::string_view(get(idx)).size());
+
+            const auto size = static_cast<size_t>(pOffsets[n]);
+            auto pChars = std::make_shared_for_overwrite<std::byte[]>(size);
+            for (size_t idx = 0; idx < n; ++idx)
+            {
+                const std::string_view str(get(idx));
+                if (!str.empty())
+                    std::memcpy(pChars.get() + pOffsets[idx], str.data(), str.size());
+            }
+
+            const int64_t* pOffsetData = pOffsets.get();
+            const std::byte* pCharData = pChars.get();
+            return BuildTuple(
+                Buffer(pOffsetData, { static_cast<Py_ssize_t>(n + 1) }, {}, std::move(pOffsets)),
+                Buffer(pCharData, { static_cast<Py_ssize_t>(size) }, {}, std::move(pChars)));
+        }
+
+        // Reads one attribute of a series of objects, resolving how to read it once per type
+        class PYCPP_API AttributeReader
+        {
+        public:
+            explicit AttributeReader(const char* pName);
+
+            // Borrowed attribute of pObject, valid until the next Read. Throws if there is none
+            [[nodiscard]] PyObject* Read(PyObject* pObject);
+
+        private:
+            void Resolve(PyTypeObject* pType) noexcept;
+
+            PyObject* m_pName = nullptr; // interned, see AttributeName
+            PyTypeObject* m_pType = nullptr;
+            unsigned int m_typeVersion = 0;
+            Py_ssize_t m_slotOffset = -1; // -1 if the attribute is not a slot
+            Object m_value;
+        };
+
+        inline void SetColumn(PyObject* pColumns, const char* pName, const Object& column)
+        {
+            if (PyDict_SetItem(pColumns, InternName(pName), column.get()) == -1)
+                Error::ThrowCurrent();
+        }
+
+        template<typename Row, typename Member>
+        Object RowColumn(std::span<const Row> rows, Member member)
+        {
+            using Field = std::remove_cv_t<std::remove_reference_t<decltype(rows[0].*member)>>;
+            if constexpr (isColumnItem<Field>)
+                return GatherColumn<Field>(rows.size(), [&](size_t idx) { return rows[idx].*member; });
+            else
+            {
+                static_assert(isStringColumnItem<Field>, "ToColumns: fields have to be of arithmetic, complex or string type");
+                return StringColumn(rows.size(), [&](size_t idx) -> const Field& { return rows[idx].*member; });
+            }
+        }
+
+        template<typename Columns, typename Member>
+        Object SharedColumn(const std::shared_ptr<const Columns>& pColumns, Member member)
+        {
+            const auto& column = (*pColumns).*member;
+            using Item = typename std::remove_cv_t<std::remove_reference_t<decltype(column)>>::value_type;
+            if constexpr (std::is_same_v<Item, bool>)
+            {
+                // std::vector<bool> is packed and has no data() to share
+                return GatherColumn<bool>(column.size(), [&](size_t idx) { return static_cast<bool>(column[idx]); });
+            }
+            else if constexpr (isColumnItem<Item>)
+                return Buffer(column.data(), { static_cast<Py_ssize_t>(column.size()) }, {}, pColumns);
+            else
+                return StringColumn(column.size(), [&](size_t idx) -> const Item& { return column[idx]; });
+        }
+    }
+
+    // Columns of the fields of rows, each copied once into memory owned by the Python objects
+    template<typename Row>
+    Dict<std::string, Object> ToColumns(std::span<const Row> rows)
+    {
+        static_assert(isRecord_v<Row>, "ToColumns: Row has to be described with PYCPP_RECORD");
+        Dict<std::string, Object> columns(detail::NewDict(detail::recordSize<Row>).ReleaseOwnership());
+        std::apply([&](auto... members)
+            {
+                size_t idx = 0;
+                (detail::SetColumn(columns.get(), RecordTraits<Row>::names[idx++], detail::RowColumn(rows, members)), ...);
+            }, RecordTraits<Row>::fields);
+        return columns;
+    }
+
+    template<typename Row>
+    Dict<std::string, Object> ToColumns(const std::vector<Row>& rows)
+    {
+        return ToColumns(std::span<const Row>(rows));
+    }
+
+    // Columns pointing into the vectors of a struct of vectors, which is kept alive by them.
+    // All vectors have to have the same size
+    template<typename Columns>
+    Dict<std::string, Object> ShareColumns(std::shared_ptr<const Columns> pColumns)
+    {
+        static_assert(isRecord_v<Columns>, "ShareColumns: Columns has to be described with PYCPP_RECORD");
+        static_assert(detail::AreVectorColumns<Columns>(), "ShareColumns: fields have to be std::vectors of arithmetic, complex or string type");
+
+        if (!pColumns)
+            throw Error("ShareColumns: no columns given");
+        const auto firstColumn = std::get<0>(RecordTraits<Columns>::fields);
+        const auto rows = ((*pColumns).*firstColumn).size();
+        Dict<std::string, Object> columns(detail::NewDict(detail::recordSize<Columns>).ReleaseOwnership());
+        std::apply([&](auto... members)
+            {
+                size_t idx = 0;
+                const auto addColumn = [&](auto member)
+                    {
+                        if (((*pColumns).*member).size() != rows)
+                            throw Error("ShareColumns: columns differ in length");
+                        detail::SetColumn(columns.get(), RecordTraits<Columns>::names[idx++], detail::SharedColumn(pColumns, member));
+                    };
+                (addColumn(members), ...);
+            }, RecordTraits<Columns>::fields);
+        return columns;
+    }
+
+    // Appends the attributes of all objects of sequence to the vectors of columns
+    template<typename Columns>
+    void ExtractColumns(const Object& sequence, Columns& columns)
+    {
+        static_assert(isRecord_v<Columns>, "ExtractColumns: Columns has to be described with PYCPP_RECORD");
+        static_assert(detail::AreVectorColumns<Columns>(), "ExtractColumns: fields have to be std::vectors of arithmetic, complex or string type");
+        static_assert(!detail::HasViewColumns<Columns>(), "ExtractColumns: std::string_view columns would point into temporary objects, use std::string");
+
+        // a copy of the items, the attribute lookups run Python code which might modify a list
+        const Object items = PySequence_Tuple(sequence.get());
+        if (!items)
+            Error::ThrowCurrent();
+        const auto n = static_cast<size_t>(PyTuple_GET_SIZE(items.get()));
+        PyObject** ppItems = &PyTuple_GET_ITEM(items.get(), 0);
+
+        std::vector<detail::AttributeReader> readers;
+        readers.reserve(detail::recordSize<Columns>);
+        for (const auto pName : RecordTraits<Columns>::names)
+            readers.emplace_back(pName);
+
+        std::array<size_t, detail::recordSize<Columns>> sizes{};
+        std::apply([&](auto... members)
+            {
+                size_t field = 0;
+                ((sizes[field++] = (columns.*members).size(), (columns.*members).reserve((columns.*members).size() + n)), ...);
+            }, RecordTraits<Columns>::fields);
+
+        size_t idx = 0;
+        try
+        {
+            for (; idx < n; ++idx)
+            {
+                std::apply([&](auto... members)
+                    {
+                        size_t field = 0;
+                        const auto append = [&](auto member)
+                            {
+                                auto& column = columns.*member;
+                                using Item = typename std::remove_reference_t<decltype(column)>::value_type;
+                                column.push_back(detail::UnboxItem<Item>(readers[field++].Read(ppItems[idx])));
+                            };
+                        (append(members), ...);
+                    }, RecordTraits<Columns>::fields);
+            }
+        }
+        catch (...)
+        {
+            // drop the fields of the failed row, so all columns keep the same number of rows
+            std::apply([&](auto... members)
+                {
+                    size_t field = 0;
+                    ((columns.*members).resize(sizes[field++] + idx), ...);
+                }, RecordTraits<Columns>::fields);
+            throw;
+        }
+    }
+
+    template<typename Columns>
+    [[nodiscard]] Columns ExtractColumns(const Object& sequence)
+    {
+        Columns columns;
+        ExtractColumns(sequence, columns);
+        return columns;
+    }
+
+    template<typename Columns, std::enable_if_t<!std::is_lvalue_reference_v<Columns> && isRecord_v<Columns>, int> = 0>
+    Dict<std::string, Object> ShareColumns(Columns&& columns)
+    {
+        return ShareColumns(std::shared_ptr<const Columns>(std::make_shared<Columns>(std::move(columns))));
+    }
+}
+
+#endif // PYCPP_COLUMNS_H
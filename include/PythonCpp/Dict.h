@@ -0,0 +1,381 @@
+#pragma once
+#ifndef PYCPP_DICT_H
+#define PYCPP_DICT_H
+
+/*
+    Dict<K, V> is a Python dict whose keys and values are converted to K and V, the dict
+    counterpart of List<T>. It can be built from and converted back to std::map and
+    std::unordered_map in one go:
+
+        pycpp::Dict<std::string, double> weights(std::unordered_map<std::string, double>{ ... });
+        auto result = pycpp::Dict<std::string, long>(fn.Invoke(weights)).ToMap();
+
+    Looking up a key converts it to a Python object and hashes it. When the same keys are
+    looked up in many dicts (e.g. the fields of records), create DictKeys once and pass those
+    instead. A DictKey holds the converted key (str keys are interned, so most comparisons end
+    at a pointer comparison) and its hash:
+
+        static const pycpp::DictKey price("price");
+        for (const auto& record : records)
+            sum += record.at(price);
+
+    DictKeys hold a Python object and belong to the interpreter they were created in.
+*/
+
+#include "Python.h"
+#include "Defines.h"
+#include "TypeTraits.h"
+#include "Object.h"
+#include "Error.h"
+#include "Result.h"
+#include "AttributeName.h"
+#include "BulkConversion.h"
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+namespace pycpp
+{
+    class PYCPP_API DictKey
+    {
+    public:
+        template<typename T, std::enable_if_t<isPythonBaseType_v<T> && !std::is_base_of_v<Object, T>, int> = 0>
+        explicit DictKey(const T& key)
+            : DictKey(ToObject(key))
+        {}
+
+        explicit DictKey(const char* key);
+
+        // Throws TypeError if key is not hashable
+        explicit DictKey(Object key);
+
+        explicit DictKey(const AttributeName& name);
+
+        // Borrowed key object
+        [[nodiscard]] PyObject* Get() const noexcept { return m_key.get(); }
+
+        [[nodiscard]] Py_hash_t Hash() const noexcept { return m_hash; }
+
+    private:
+        Object m_key;
+        Py_hash_t m_hash = -1;
+    };
+
+    namespace detail
+    {
+        // Borrowed value for key, nullptr if there is none. The Python error is set if the lookup failed
+        PYCPP_API PyObject* DictGetItem(PyObject* pDict, const DictKey& key) noexcept;
+
+        PYCPP_API void DictSetItem(PyObject* pDict, const DictKey& key, PyObject* pValue);
+
+        PYCPP_API bool DictContains(PyObject* pDict, const DictKey& key);
+
+        // Sets KeyError(key) the way dict does, tuple keys are wrapped so they are not taken as the args
+        PYCPP_API void SetKeyError(PyObject* pKey) noexcept;
+
+        // New dict with room for n items
+        inline Object NewDict(size_t n)
+        {
+#ifndef Py_LIMITED_API
+            Object dict = _PyDict_NewPresized(static_cast<Py_ssize_t>(n));
+#else
+            (void)n;
+            Object dict = PyDict_New();
+#endif // Py_LIMITED_API
+            if (!dict)
+                Error::ThrowCurrent();
+            return dict;
+        }
+
+        // New dict with the n key value pairs starting at first
+        template<typename It>
+        Object BuildDict(It first, size_t n)
+        {
+            Object dict = NewDict(n);
+            for (size_t idx = 0; idx < n; ++idx, ++first)
+            {
+                const auto& [key, value] = *first;
+                const Object pyKey(NewReference(key));
+                const Object pyValue(NewReference(value));
+                if (PyDict_SetItem(dict.get(), pyKey.get(), pyValue.get()) == -1)
+                    Error::ThrowCurrent();
+            }
+            return dict;
+        }
+
+        // Input iterator over the items of a dict using PyDict_Next. Key and value are borrowed
+        // and converted when dereferenced. The dict must not be modified while iterating
+        template<typename K, typename V>
+        class DictIterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = std::pair<K, V>;
+            using difference_type = std::ptrdiff_t;
+            using reference = value_type;
+
+            DictIterator() noexcept = default;
+
+            explicit DictIterator(PyObject* pDict) noexcept
+                : m_pDict(pDict), m_pos(0)
+            {
+                ++*this;
+            }
+
+            value_type operator*() const
+            {
+                return value_type(UnboxItem<K>(m_pKey), UnboxItem<V>(m_pValue));
+            }
+
+            // Borrowed key and value of the current item
+            [[nodiscard]] PyObject* key() const noexcept { return m_pKey; }
+            [[nodiscard]] PyObject* value() const noexcept { return m_pValue; }
+
+            DictIterator& operator++() noexcept
+            {
+                if (!PyDict_Next(m_pDict, &m_pos, &m_pKey, &m_pValue))
+                    m_pos = -1;
+                return *this;
+            }
+
+            DictIterator operator++(int) noexcept
+            {
+                auto copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            friend bool operator==(const DictIterator& lhs, const DictIterator& rhs) noexcept
+            {
+                return lhs.m_pos == rhs.m_pos;
+            }
+
+        private:
+            PyObject* m_pDict = nullptr;
+            Py_ssize_t m_pos = -1; // -1 for end()
+            PyObject* m_pKey = nullptr;
+            PyObject* m_pValue = nullptr;
+        };
+    }
+
+    template<typename K, typename V>
+    class Dict : public Object
+    {
+        static_assert(isPythonBaseType_v<K>, "Dict<K, V>: K is not a valid PythonBaseType");
+        static_assert(isPythonBaseType_v<V>, "Dict<K, V>: V is not a valid PythonBaseType");
+
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using const_iterator = detail::DictIterator<K, V>;
+        using iterator = const_iterator;
+
+        // Default constructor will create a new empty dict, analog to myDict = {} in Python
+        Dict()
+            : Object(detail::NewDict(0))
+        {}
+
+        Dict(const std::initializer_list<std::pair<const K, V>>& iList)
+            : Object(detail::BuildDict(iList.begin(), iList.size()))
+        {}
+
+        template<typename Map, typename key_t = typename Map::key_type, typename mapped_t = typename Map::mapped_type,
+            std::enable_if_t<isPythonBaseType_v<key_t> && isPythonBaseType_v<mapped_t>, int> = 0>
+        Dict(const Map& map)
+            : Object(detail::BuildDict(std::begin(map), static_cast<size_t>(std::size(map))))
+        {}
+
+        // Take ownership of an existing PyObject which points to a Python dict or subtype of dict
+        // Will throw Error if object pointed to by PyObject* is not of dict type
+        Dict(PyObject* pDictObj)
+            :Object(pDictObj)
+        {
+            if (PyDict_Check(pDictObj) == 0)
+                throw Error("PyObject not of Dict type");
+        }
+
+        Dict(const Dict& other)
+            :Object(other)
+        {}
+
+        Dict& operator=(const Dict& other)
+        {
+            Object::operator=(other);
+            return *this;
+        }
+
+        Dict(Dict&& other) noexcept
+            :Object(std::move(other))
+        {}
+
+        Dict& operator=(Dict&& other) noexcept
+        {
+            Object::operator=(std::move(other));
+            return *this;
+        }
+
+        Dict(const Object& other)
+            :Object(other)
+        {
+            if (PyDict_Check(m_pObject) == 0)
+                throw Error("PyObject not of Dict type");
+        }
+
+        Dict& operator=(const Object& other)
+        {
+            if (PyDict_Check(other.get()) == 0)
+                throw Error("PyObject not of Dict type");
+            Object::operator=(other);
+            return *this;
+        }
+
+        // Note: No move construction/assignment from Object, because due to the PyDict_Check
+        // they cannot be defined noexcept!
+
+        [[nodiscard]] size_t size() const noexcept
+        {
+            return static_cast<size_t>(PyDict_Size(m_pObject));
+        }
+
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+            return const_iterator(m_pObject);
+        }
+
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+            return const_iterator();
+        }
+
+        [[nodiscard]] bool contains(const K& key) const
+        {
+            const Object pyKey(detail::NewReference(key));
+            const auto ret = PyDict_Contains(m_pObject, pyKey.get());
+            if (ret == -1)
+                Error::ThrowCurrent();
+            return ret == 1;
+        }
+
+        [[nodiscard]] bool contains(const DictKey& key) const
+        {
+            return detail::DictContains(m_pObject, key);
+        }
+
+        // Throws KeyError if there is no item for key
+        [[nodiscard]] V at(const K& key) const
+        {
+            return TryAt(key).value();
+        }
+
+        [[nodiscard]] V at(const DictKey& key) const
+        {
+            return TryAt(key).value();
+        }
+
+        [[nodiscard]] Result<V> TryAt(const K& key) const
+        {
+            const auto pyKey = detail::CatchErrors<Object>([&key] { return Object(detail::NewReference(key)); });
+            if (!pyKey)
+                return pyKey.error();
+            return Convert(PyDict_GetItemWithError(m_pObject, pyKey->get()), pyKey->get());
+        }
+
+        [[nodiscard]] Result<V> TryAt(const DictKey& key) const
+        {
+            return Convert(detail::DictGetItem(m_pObject, key), key.Get());
+        }
+
+        // get(key, default) would hide the PyObject* accessor otherwise
+        using Object::get;
+
+        // Value for key or defaultValue if there is none, analog to dict.get(key, default)
+        [[nodiscard]] V get(const K& key, const V& defaultValue) const
+        {
+            const Object pyKey(detail::NewReference(key));
+            return ConvertOr(PyDict_GetItemWithError(m_pObject, pyKey.get()), defaultValue);
+        }
+
+        [[nodiscard]] V get(const DictKey& key, const V& defaultValue) const
+        {
+            return ConvertOr(detail::DictGetItem(m_pObject, key), defaultValue);
+        }
+
+        void set(const K& key, const V& value)
+        {
+            const Object pyKey(detail::NewReference(key));
+            const Object pyValue(detail::NewReference(value));
+            if (PyDict_SetItem(m_pObject, pyKey.get(), pyValue.get()) == -1)
+                Error::ThrowCurrent();
+        }
+
+        void set(const DictKey& key, const V& value)
+        {
+            const Object pyValue(detail::NewReference(value));
+            detail::DictSetItem(m_pObject, key, pyValue.get());
+        }
+
+        // Throws KeyError if there is no item for key
+        void erase(const K& key)
+        {
+            const Object pyKey(detail::NewReference(key));
+            if (PyDict_DelItem(m_pObject, pyKey.get()) == -1)
+                Error::ThrowCurrent();
+        }
+
+        void clear() noexcept
+        {
+            PyDict_Clear(m_pObject);
+        }
+
+        // Values of exact float and small int type are unboxed directly, see BulkConversion.h
+        template<typename Map = std::unordered_map<K, V>>
+        [[nodiscard]] Map ToMap() const
+        {
+            Map ret;
+            ToMap(ret);
+            return ret;
+        }
+
+        // Same as above, but reuses the memory of out (if Map supports it)
+        template<typename Map>
+        void ToMap(Map& out) const
+        {
+            out.clear();
+            if constexpr (requires { out.reserve(size_t{}); })
+                out.reserve(size());
+            for (auto it = begin(); it != end(); ++it)
+                out.emplace(detail::UnboxItem<K>(it.key()), detail::UnboxItem<V>(it.value()));
+        }
+
+    private:
+        static Result<V> Convert(PyObject* pValue, PyObject* pKey)
+        {
+            if (!pValue)
+            {
+                if (!PyErr_Occurred())
+                    detail::SetKeyError(pKey);
+                return ErrorInfo::Fetch();
+            }
+            return try_python_cast<V>(pValue);
+        }
+
+        static V ConvertOr(PyObject* pValue, const V& defaultValue)
+        {
+            if (!pValue)
+            {
+                if (PyErr_Occurred())
+                    Error::ThrowCurrent();
+                return defaultValue;
+            }
+            return python_cast<V>(pValue);
+        }
+    };
+
+    template<typename Map>
+    Dict(const Map& map)->Dict<typename Map::key_type, typename Map::mapped_type>;
+}
+
+#endif // PYCPP_DICT_H
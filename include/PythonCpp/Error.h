@@ -3,30 +3,149 @@
 #define PYTHON_ERROR_H
 
 #include "Python.h"
+#include <memory>
 #include <stdexcept>
 #include "Object.h"
 
 namespace pycpp
 {
+    class ErrorInfo;
+
+    namespace detail
+    {
+        struct ErrorState;
+
+        // Takes over the current Python exception, null if there is none. Needs the GIL
+        PYCPP_API std::shared_ptr<ErrorState> FetchErrorState();
+    }
+
     /*
         Error represents the type of exception that will be thrown if any call to a Python
-        C API function returns an error value. It will fetch the error/exception details from Python
-        and make them available by calling what();
+        C API function returns an error value. It takes over the pending Python exception and
+        formats it only when what() is called, so errors that are caught and ignored (e.g. probing
+        for a key) cost no more than fetching the exception. Common Python exceptions are thrown
+        as the subclasses below by ThrowCurrent, everything else as Error.
         You can also provide a custom error message
+
+        The exception objects belong to the interpreter they were raised in. what() and the
+        destructor acquire the GIL of the main interpreter if needed; errors raised in other
+        interpreters have to be detached (Detach) before they are handed to another thread.
     */
 
     class PYCPP_API Error : public std::runtime_error
     {
+        friend class ErrorInfo;
     public:
+        // Takes over the current Python exception
         Error();
 
         explicit Error(const std::string& errMsg);
 
         explicit Error(const char* errMsg);
 
+        // Formats the message on first use
+        [[nodiscard]] const char* what() const noexcept override;
+
+        // The Python exception, null for custom messages and detached errors. Needs the GIL
+        [[nodiscard]] Object Type() const;
+        [[nodiscard]] Object Value() const;
+        [[nodiscard]] Object Traceback() const;
+
+        // True if the Python exception is an instance of pExceptionType (e.g. PyExc_KeyError). Needs the GIL
+        [[nodiscard]] bool Matches(PyObject* pExceptionType) const noexcept;
+
+        // Sets the exception as the current Python exception again, e.g. to return it to Python. Needs the GIL
+        void Restore() const;
+
+        // Formats the message and releases the Python objects, so the error can be passed to threads
+        // that do not hold the GIL of its interpreter. Needs the GIL
+        void Detach() const noexcept;
+
+        // Throws the subclass of Error matching the current Python exception
+        [[noreturn]] static void ThrowCurrent();
+
     public:
         static std::string RetrievePyErrorString();
+
+    private:
+        std::shared_ptr<detail::ErrorState> m_pState;
+    };
+
+    // Thrown for the Python exceptions of the same name (including their subclasses)
+    class PYCPP_API TypeError : public Error
+    {
+    public:
+        using Error::Error;
+        TypeError() = default;
+    };
+
+    class PYCPP_API ValueError : public Error
+    {
+    public:
+        using Error::Error;
+        ValueError() = default;
+    };
+
+    class PYCPP_API KeyError : public Error
+    {
+    public:
+        using Error::Error;
+        KeyError() = default;
+    };
+
+    class PYCPP_API IndexError : public Error
+    {
+    public:
+        using Error::Error;
+        IndexError() = default;
+    };
+
+    class PYCPP_API AttributeError : public Error
+    {
+    public:
+        using Error::Error;
+        AttributeError() = default;
     };
+
+    class PYCPP_API ImportError : public Error
+    {
+    public:
+        using Error::Error;
+        ImportError() = default;
+    };
+
+    class PYCPP_API OverflowError : public Error
+    {
+    public:
+        using Error::Error;
+        OverflowError() = default;
+    };
+
+    class PYCPP_API StopIteration : public Error
+    {
+    public:
+        using Error::Error;
+        StopIteration() = default;
+    };
+
+    namespace detail
+    {
+        // Calls fn and detaches any Error it throws, for work whose exceptions are passed on to
+        // other threads
+        template<typename Fn>
+        decltype(auto) DetachErrors(Fn&& fn)
+        {
+            try
+            {
+                return fn();
+            }
+            catch (const Error& e)
+            {
+                e.Detach();
+                throw;
+            }
+        }
+    }
 }
 
 #endif //PYTHON_ERROR_H
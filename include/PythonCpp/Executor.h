@@ -0,0 +1,158 @@
+#pragma once
+#ifndef PYCPP_EXECUTOR_H
+#define PYCPP_EXECUTOR_H
+
+/*
+    A dedicated thread that runs Python work submitted from any other thread. Submitting is a
+    lock-free push onto a multi-producer queue; the executor drains the queue while holding the
+    GIL and only releases it once there is nothing left to do. So under load the GIL stays on one
+    thread instead of moving between all callers on every call, and callers never block on it:
+
+        pycpp::Interpreter::Executor executor;
+        std::future<double> result = executor.Submit<double>(fn, 1.0, 2.0);
+        ...
+        double value = result.get();
+
+    Arguments are converted to Python objects and the result is converted to T on the executor,
+    so only C++ values cross threads. Objects can not be copied without holding the GIL, so they
+    can only be passed as arguments by moving them in, and never be returned. The submitted
+    Callable is borrowed and has to stay alive until the call has run.
+
+    The executor keeps the interpreter open while it exists. Its destructor runs all tasks that
+    were submitted so far before the thread is joined.
+*/
+
+#include "Python.h"
+#include "Defines.h"
+#include "Object.h"
+#include "Interpreter.h"
+#include "Callable.h"
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace pycpp
+{
+    namespace detail
+    {
+        struct ExecutorNode
+        {
+            std::atomic<ExecutorNode*> pNext = nullptr;
+        };
+
+        struct ExecutorTask : ExecutorNode
+        {
+            virtual ~ExecutorTask() = default;
+            virtual void Run() noexcept = 0;
+        };
+
+        template<typename R, typename Fn>
+        struct PackagedExecutorTask : ExecutorTask
+        {
+            explicit PackagedExecutorTask(Fn&& fn)
+                : task(std::move(fn))
+            {}
+
+            void Run() noexcept override
+            {
+                // exceptions are stored in the future
+                task();
+            }
+
+            std::packaged_task<R()> task;
+        };
+
+        // Intrusive multi-producer single-consumer queue (Vyukov). Push is wait-free, Pop may only
+        // be called by one thread and returns nullptr if the queue is empty or a push is in progress
+        class PYCPP_API TaskQueue
+        {
+        public:
+            TaskQueue() noexcept;
+
+            TaskQueue(const TaskQueue& other) = delete;
+            TaskQueue& operator=(const TaskQueue& other) = delete;
+
+            void Push(ExecutorTask* pTask) noexcept;
+            ExecutorTask* Pop() noexcept;
+
+        private:
+            void Push(ExecutorNode* pNode) noexcept;
+
+            std::atomic<ExecutorNode*> m_pHead;
+            ExecutorNode* m_pTail;
+            ExecutorNode m_stub;
+        };
+
+        template<typename T>
+        constexpr bool isExecutorArgument = !std::is_base_of_v<Object, std::remove_cvref_t<T>> ||
+            (!std::is_lvalue_reference_v<T> && !std::is_const_v<std::remove_reference_t<T>>);
+    }
+
+    class PYCPP_API Interpreter::Executor
+    {
+    public:
+        // Starts the executor thread. Opens the interpreter if needed
+        Executor();
+
+        // Runs all submitted tasks and joins the executor thread
+        ~Executor();
+
+        Executor(const Executor& other) = delete;
+        Executor& operator=(const Executor& other) = delete;
+
+        // Runs fn on the executor thread while holding the GIL
+        template<typename Fn>
+        auto Submit(Fn&& fn)
+        {
+            using Result = std::invoke_result_t<std::decay_t<Fn>&>;
+            static_assert(!std::is_base_of_v<Object, std::decay_t<Result>>,
+                "Executor: results can not be Objects, convert them to a C++ type on the executor");
+
+            using Task = detail::PackagedExecutorTask<Result, std::decay_t<Fn>>;
+            auto* pTask = new Task(std::decay_t<Fn>(std::forward<Fn>(fn)));
+            auto future = pTask->task.get_future();
+            Post(pTask);
+            return future;
+        }
+
+        // Calls callable(args...) on the executor thread and converts the result to T there.
+        // With T = void the result is discarded
+        template<typename T, typename... Args>
+        std::future<T> Submit(const Callable& callable, Args&&... args)
+        {
+            static_assert((detail::isExecutorArgument<Args&&> && ...),
+                "Executor: Objects can only be passed by moving them in, copying them requires the GIL");
+
+            return Submit([pCallable = &callable, tuple = std::make_tuple(std::forward<Args>(args)...)]() -> T
+                {
+                    return std::apply([pCallable](const auto&... args) -> T
+                        {
+                            auto result = pCallable->Invoke(args...);
+                            if constexpr (!std::is_void_v<T>)
+                                return python_cast<T>(result);
+                        }, tuple);
+                });
+        }
+
+        // Number of tasks that were submitted but did not finish yet
+        [[nodiscard]] size_t Pending() const noexcept { return m_pending.load(std::memory_order_relaxed); }
+
+    private:
+        void Post(detail::ExecutorTask* pTask) noexcept;
+        void Run() noexcept;
+
+        detail::TaskQueue m_queue;
+        // bumped after every push, the idle executor waits for it to change
+        std::atomic<uint32_t> m_signal = 0;
+        std::atomic<size_t> m_pending = 0;
+        std::atomic<bool> m_stop = false;
+        InterpreterHandle m_handle;
+        std::thread m_thread;
+    };
+}
+
+#endif // PYCPP_EXECUTOR_H
@@ -0,0 +1,228 @@
+#pragma once
+#ifndef PYCPP_FUNCTION_H
+#define PYCPP_FUNCTION_H
+
+/*
+    Function exposes a C++ callable (function pointer, lambda, functor) to Python as a builtin
+    function using METH_FASTCALL, so Python calls it through vectorcall without an argument tuple:
+
+        pycpp::Function lookup("lookup", [&cache](const std::string& key, long fallback)
+            {
+                return cache.Get(key, fallback);
+            });
+        plugin.Invoke(lookup); // the plugin calls lookup("price", 0) like any other function
+
+    The conversion of the arguments is generated from the signature of the callable: every
+    parameter is converted with python_cast (Object and PyObject* parameters are passed through,
+    PyObject* borrowed), the result with ToObject. Results of type Result<T> return their error
+    to Python. PyObject* results are borrowed, the function adds the reference it returns.
+
+    Exceptions thrown by the callable are translated into Python exceptions: Error restores its
+    Python exception (Errors created in C++ raise the Python exception their class is named
+    after, plain Error RuntimeError), std::out_of_range becomes IndexError, std::invalid_argument and
+    std::domain_error ValueError, std::overflow_error OverflowError, std::bad_alloc MemoryError
+    and any other exception RuntimeError.
+
+    The callable is destroyed with the Python function object, so it has to be safe to destroy
+    it while holding the GIL (e.g. captured Objects are fine). The function object is not tracked
+    by the cycle GC, which can't see into the captures: a callable that captures an Object
+    referring back to the function (e.g. a plugin it was registered with as callback) forms a
+    cycle that is never freed. Capture such objects weakly or break the cycle explicitly.
+*/
+
+#include "Python.h"
+#include "Defines.h"
+#include "Object.h"
+#include "Error.h"
+#include "Result.h"
+#include "TypeTraits.h"
+#include "BulkConversion.h"
+#include "Callable.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace pycpp
+{
+    namespace detail
+    {
+        // Parameter and result types of a callable
+        template<typename T>
+        struct Signature : Signature<decltype(&T::operator())>
+        {};
+
+        template<typename R, typename... Args>
+        struct Signature<R(*)(Args...)>
+        {
+            using result = R;
+            using arguments = std::tuple<Args...>;
+        };
+
+        template<typename R, typename... Args>
+        struct Signature<R(*)(Args...) noexcept> : Signature<R(*)(Args...)>
+        {};
+
+        template<typename C, typename R, typename... Args>
+        struct Signature<R(C::*)(Args...)> : Signature<R(*)(Args...)>
+        {};
+
+        template<typename C, typename R, typename... Args>
+        struct Signature<R(C::*)(Args...) const> : Signature<R(*)(Args...)>
+        {};
+
+        template<typename C, typename R, typename... Args>
+        struct Signature<R(C::*)(Args...) noexcept> : Signature<R(*)(Args...)>
+        {};
+
+        template<typename C, typename R, typename... Args>
+        struct Signature<R(C::*)(Args...) const noexcept> : Signature<R(*)(Args...)>
+        {};
+
+        template<typename T>
+        struct isResult : std::false_type
+        {};
+
+        template<typename T>
+        struct isResult<Result<T>> : std::true_type
+        {};
+
+        // Sets the C++ exception currently being handled as Python exception, see above. Has to be
+        // called from a catch block
+        PYCPP_API void SetCurrentException() noexcept;
+
+        template<typename T>
+        using ArgumentValue = std::remove_cv_t<std::remove_reference_t<T>>;
+
+        template<typename T>
+        T ConvertArgument(PyObject* pArg)
+        {
+            if constexpr (std::is_same_v<T, PyObject*>)
+                return pArg;
+            else
+                return python_cast<T>(pArg);
+        }
+
+        // Moves the converted value into by-value and rvalue reference parameters
+        template<typename Arg, typename Value>
+        decltype(auto) PassArgument(Value& value) noexcept
+        {
+            if constexpr (std::is_lvalue_reference_v<Arg>)
+                return (value);
+            else
+                return std::move(value);
+        }
+
+        template<typename R, typename Arguments, typename Fn, size_t... idx>
+        PyObject* InvokeConverted(Fn&& fn, PyObject* const* ppArgs, std::index_sequence<idx...>)
+        {
+            // braced initialization converts the arguments from left to right
+            std::tuple<ArgumentValue<std::tuple_element_t<idx, Arguments>>...> values{
+                ConvertArgument<ArgumentValue<std::tuple_element_t<idx, Arguments>>>(ppArgs[idx])... };
+            (void)values;
+
+            if constexpr (std::is_void_v<R>)
+            {
+                fn(PassArgument<std::tuple_element_t<idx, Arguments>>(std::get<idx>(values))...);
+                Py_INCREF(Py_None);
+                return Py_None;
+            }
+            else if constexpr (isResult<ArgumentValue<R>>::value)
+            {
+                auto result = fn(PassArgument<std::tuple_element_t<idx, Arguments>>(std::get<idx>(values))...);
+                if (!result)
+                {
+                    result.error().Restore();
+                    return nullptr;
+                }
+                return NewReference(std::move(*result));
+            }
+            else
+                return NewReference(fn(PassArgument<std::tuple_element_t<idx, Arguments>>(std::get<idx>(values))...));
+        }
+
+        // Calls fn with ppArgs converted to the parameter types in Arguments (a std::tuple) and
+        // returns a new reference to its converted result R, see Function. Throws on failure
+        template<typename R, typename Arguments, typename Fn>
+        PyObject* InvokeConverted(Fn&& fn, PyObject* const* ppArgs)
+        {
+            return InvokeConverted<R, Arguments>(std::forward<Fn>(fn), ppArgs, std::make_index_sequence<std::tuple_size_v<Arguments>>());
+        }
+
+        class PYCPP_API FunctionBase
+        {
+        public:
+            explicit FunctionBase(size_t arity) noexcept
+                : m_arity(static_cast<Py_ssize_t>(arity))
+            {}
+
+            virtual ~FunctionBase() = default;
+
+            FunctionBase(const FunctionBase& other) = delete;
+            FunctionBase& operator=(const FunctionBase& other) = delete;
+
+            [[nodiscard]] Py_ssize_t Arity() const noexcept
+            {
+                return m_arity;
+            }
+
+            // New reference to the result, nullptr with the Python error set on failure. The number
+            // of arguments has already been checked
+            virtual PyObject* Call(PyObject* const* ppArgs) noexcept = 0;
+
+        private:
+            Py_ssize_t m_arity;
+        };
+
+        template<typename Fn>
+        class FunctionImpl : public FunctionBase
+        {
+            using Arguments = typename Signature<Fn>::arguments;
+            using R = typename Signature<Fn>::result;
+
+        public:
+            explicit FunctionImpl(Fn fn)
+                : FunctionBase(std::tuple_size_v<Arguments>), m_fn(std::move(fn))
+            {}
+
+            PyObject* Call(PyObject* const* ppArgs) noexcept override
+            {
+                try
+                {
+                    return InvokeConverted<R, Arguments>(m_fn, ppArgs);
+                }
+                catch (...)
+                {
+                    SetCurrentException();
+                    return nullptr;
+                }
+            }
+
+        private:
+            Fn m_fn;
+        };
+
+        // New builtin function object calling pImpl
+        PYCPP_API Object MakeFunction(std::unique_ptr<FunctionBase> pImpl, std::string name, std::string doc);
+    }
+
+    class PYCPP_API Function : public Callable
+    {
+    public:
+        // name is the __name__ of the function in Python, doc its optional __doc__
+        template<typename Fn, std::enable_if_t<!std::is_base_of_v<Object, std::decay_t<Fn>>, int> = 0>
+        Function(std::string name, Fn&& fn, std::string doc = {})
+            : Callable(detail::MakeFunction(std::make_unique<detail::FunctionImpl<std::decay_t<Fn>>>(std::forward<Fn>(fn)),
+                std::move(name), std::move(doc)).ReleaseOwnership())
+        {}
+
+        Function(const Function& other);
+        Function& operator=(const Function& other);
+        Function(Function&& other) noexcept;
+        Function& operator=(Function&& other) noexcept;
+    };
+}
+
+#endif // PYCPP_FUNCTION_H
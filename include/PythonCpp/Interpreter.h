@@ -8,12 +8,32 @@
     Use the Open() method to before any other Python related code. Close() when done. Opening
     multiple times will increase the ref count of the interpreter handle. If all clients close,
     Python will be finalized. Else Python will be finalized on destruction of the App.
+
+    Threading: the thread that initializes Python holds the GIL afterwards. Any other thread has
+    to hold the GIL (GILAcquire) while it uses the Python C API, including creating or destroying
+    Objects. Long running C++ sections should release the GIL (GILRelease) so other threads
+    can run Python code in the meantime:
+
+        auto handle = pycpp::Interpreter::Handle();
+        pycpp::GILRelease release;          // main thread lets go of the GIL
+        std::thread worker([]
+            {
+                pycpp::GILAcquire gil;      // worker runs Python code
+                ...
+            });
 */
 
 #include "Python.h"
 #include "Defines.h"
+#include "Object.h"
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <memory>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace pycpp
 {
@@ -29,6 +49,126 @@ namespace pycpp
             ~PyInstance();
             PyInstance(const PyInstance& other) = delete;
             PyInstance& operator=(const PyInstance& other) = delete;
+
+        private:
+            PyThreadState* m_pMainThreadState = nullptr;
+        };
+
+        // True if the calling thread currently holds the GIL
+        PYCPP_API bool HoldsGIL() noexcept;
+
+        // Identifies one interpreter for its whole lifetime. The generation changes each time Python
+        // is (re)initialized, so keys of a finalized interpreter never match again
+        struct InterpreterKey
+        {
+            uint64_t generation = 0;
+            int64_t id = -1;
+
+            constexpr bool operator==(const InterpreterKey& other) const noexcept
+            {
+                return generation == other.generation && id == other.id;
+            }
+
+            constexpr bool operator!=(const InterpreterKey& other) const noexcept
+            {
+                return !(*this == other);
+            }
+
+            constexpr bool operator<(const InterpreterKey& other) const noexcept
+            {
+                return generation < other.generation || (generation == other.generation && id < other.id);
+            }
+        };
+
+        // Must be called with the GIL held
+        PYCPP_API InterpreterKey CurrentInterpreterKey() noexcept;
+
+        // True if the calling thread holds the GIL of the interpreter identified by key
+        PYCPP_API bool IsCurrentInterpreter(const InterpreterKey& key) noexcept;
+
+        // True if key identifies the main interpreter and it was not finalized yet. Does not need the GIL
+        PYCPP_API bool IsMainInterpreterAlive(const InterpreterKey& key) noexcept;
+
+        // True if the interpreter identified by key is known to be finalized. Interpreters are known
+        // once their state was released (see ReleaseInterpreterState). Does not need the GIL
+        PYCPP_API bool IsInterpreterEnded(const InterpreterKey& key);
+
+        // Hash for lookups of std::string keys by std::string_view
+        struct StringHash
+        {
+            using is_transparent = void;
+
+            size_t operator()(std::string_view str) const noexcept
+            {
+                return std::hash<std::string_view>()(str);
+            }
+        };
+
+        // State that is kept per interpreter and released right before it is finalized
+        struct InterpreterState
+        {
+            // interned str objects by their UTF-8 contents; the keys view the buffers of the str objects
+            std::unordered_map<std::string_view, Object> internedNames;
+
+            // modules imported through ModuleCache by name
+            std::unordered_map<std::string, Object, StringHash, std::equal_to<>> modules;
+        };
+
+        // Must be called with the GIL held
+        PYCPP_API InterpreterState& CurrentInterpreterState();
+
+        // Releases all state of the current interpreter. Called right before the interpreter is finalized
+        PYCPP_API void ReleaseInterpreterState();
+
+        /*
+            Lazily created reference which is bound to the interpreter it was created in. Meant to be
+            used as a static or long-lived member to cache objects per call site. Every interpreter
+            (a sub-interpreter or a reinitialized one) gets its own object; lookups from different
+            interpreters may happen concurrently. References are only released when the owning
+            object is destroyed within the interpreter they belong to, otherwise they are dropped.
+            The slot of an ended interpreter is reused by the next interpreter that needs one.
+        */
+        class PYCPP_API InterpreterLocalRef
+        {
+        public:
+            constexpr InterpreterLocalRef() noexcept = default;
+
+            ~InterpreterLocalRef();
+
+            // Copies start out empty, the cached objects are recreated on first use
+            InterpreterLocalRef(const InterpreterLocalRef& other) noexcept;
+            InterpreterLocalRef& operator=(const InterpreterLocalRef& other) noexcept;
+
+            // Borrowed pointer to the cached object. factory is called if there is none yet for the
+            // current interpreter and has to return a new (owned) Object
+            template<typename Factory>
+            PyObject* Get(Factory&& factory) const
+            {
+                const auto key = CurrentInterpreterKey();
+                if (auto pObject = Find(key))
+                    return pObject;
+                return Insert(key, factory());
+            }
+
+            // Number of slots, including the ones of ended interpreters that were not reused yet
+            [[nodiscard]] size_t SlotCount() const noexcept;
+
+        private:
+            struct Node
+            {
+                // a generation of 0 marks a node that is being reused
+                std::atomic<uint64_t> generation;
+                std::atomic<int64_t> id;
+                std::atomic<PyObject*> pObject;
+                Node* pNext;
+            };
+
+            PyObject* Find(const InterpreterKey& key) const noexcept;
+            PyObject* Insert(const InterpreterKey& key, Object object) const;
+            static bool TryReuse(Node* pNode, const InterpreterKey& key, PyObject* pObject);
+
+            // nodes are only ever prepended and never unlinked, so readers need no lock
+            mutable std::atomic<Node*> m_pHead = nullptr;
         };
     }
 
@@ -57,23 +197,66 @@ namespace pycpp
     class PYCPP_API Interpreter
     {
     public:
+        // Dedicated thread running Python work submitted from other threads, see Executor.h
+        class Executor;
+
         static void Open();
         static void Close();
         static InterpreterHandle Handle();
 
-        /* 
-            if you want to access the interpreter from multiple threads,
-            retrieve the lock for each task first. Unsynchronized use of
-            the interpreter will lead to undefined behaviour. Any multithreading 
-            in the Python interpreter should be handled from the Python code itself
+        /*
+            Mutex for callers that want to serialize whole tasks on the C++ side. This does not
+            replace the GIL: Python code is only safe to run while holding it, see GILAcquire.
+            Open/Close are synchronized independently of this lock.
         */
-        [[nodiscard]] static auto getLock();
+        [[nodiscard]] static std::unique_lock<std::mutex> getLock();
 
     private:
         static size_t s_refCnt;
+        static std::mutex s_refMutex;
         static std::mutex s_mutex;
         static std::unique_ptr<detail::PyInstance> s_pInterpreter;
     };
+
+    /*
+        Acquires the GIL for the calling thread for the lifetime of the guard. Does nothing if the
+        thread already holds it, so guards can be nested. Each thread creates its PyThreadState
+        once and reuses it for every later guard (PyGILState_Ensure would create and destroy one
+        per outermost call), which keeps this cheap for thread pools. When the thread exits, its
+        thread state is handed over to be deleted by the next thread that acquires the GIL (or by
+        Python on finalization), so threads can exit and be joined while another thread holds
+        the GIL.
+    */
+    class PYCPP_API GILAcquire
+    {
+    public:
+        GILAcquire();
+        ~GILAcquire();
+
+        GILAcquire(const GILAcquire& other) = delete;
+        GILAcquire& operator=(const GILAcquire& other) = delete;
+
+    private:
+        bool m_acquired = false;
+    };
+
+    /*
+        Releases the GIL held by the calling thread for the lifetime of the guard, so other threads
+        can run Python code while this one does C++ work. No Python API (and no Object) may be
+        used by this thread until the guard is destroyed.
+    */
+    class PYCPP_API GILRelease
+    {
+    public:
+        GILRelease();
+        ~GILRelease();
+
+        GILRelease(const GILRelease& other) = delete;
+        GILRelease& operator=(const GILRelease& other) = delete;
+
+    private:
+        PyThreadState* m_pThreadState = nullptr;
+    };
 }
 
 #endif // PYTHON_INTERPRETER_H
@@ -0,0 +1,156 @@
+#pragma once
+#ifndef PYCPP_INTERPRETER_POOL_H
+#define PYCPP_INTERPRETER_POOL_H
+
+/*
+    Pool of sub-interpreters to run Python code in parallel within one process. Each
+    sub-interpreter lives on its own worker thread. Since Python 3.12 every sub-interpreter is
+    created with its own GIL (PyInterpreterConfig_OWN_GIL), so the workers do not contend on the
+    GIL of the main interpreter or of each other. Older versions fall back to Py_NewInterpreter,
+    where all interpreters share one GIL and the pool only isolates their state.
+
+        pycpp::InterpreterPool pool(4);
+        pool.Broadcast([] { pycpp::ImportModule("json"); });   // warm up every interpreter
+        auto result = pool.Submit([] { return pycpp::python_cast<double>(...); });
+        double value = result.get();
+
+    Tasks run inside their sub-interpreter with its GIL held. Python objects must never cross
+    interpreters: tasks may not capture Objects of the calling interpreter nor return plain
+    Objects. A task can hand out a PinnedObject, which remembers the interpreter it belongs to
+    and can only be used there again (SubmitTo with its Owner()).
+
+    The pool has to be created after and destroyed before Python is finalized. Creating and
+    destroying it releases the GIL of the calling thread while the workers start up and shut
+    down. Extension modules that do not support multiple interpreters can not be imported in
+    the sub-interpreters. With a shared GIL (before 3.12), wait for results without holding
+    the GIL, otherwise the workers can never run.
+*/
+
+#include "Python.h"
+#include "Defines.h"
+#include "Object.h"
+#include "Error.h"
+#include "Interpreter.h"
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pycpp
+{
+    namespace detail
+    {
+        struct PoolWorker;
+    }
+
+    /*
+        Reference to an object together with the interpreter it was created in. Accessing it from
+        any other interpreter throws. If it is destroyed outside of its interpreter, the reference
+        is handed back to the pool worker running that interpreter, or dropped if there is none.
+    */
+    class PYCPP_API PinnedObject
+    {
+    public:
+        PinnedObject() noexcept = default;
+
+        // Must be called in the interpreter object belongs to
+        explicit PinnedObject(Object object);
+
+        ~PinnedObject();
+
+        PinnedObject(const PinnedObject& other) = delete;
+        PinnedObject& operator=(const PinnedObject& other) = delete;
+        PinnedObject(PinnedObject&& other) noexcept;
+        PinnedObject& operator=(PinnedObject&& other) noexcept;
+
+        // The pinned object, throws if called outside of its interpreter
+        [[nodiscard]] Object get() const;
+
+        [[nodiscard]] const detail::InterpreterKey& Owner() const noexcept { return m_owner; }
+
+        explicit operator bool() const noexcept { return m_pObject != nullptr; }
+
+    private:
+        void Release() noexcept;
+
+        PyObject* m_pObject = nullptr;
+        detail::InterpreterKey m_owner{};
+    };
+
+    class PYCPP_API InterpreterPool
+    {
+    public:
+        // True if the sub-interpreters run with their own GIL (Python 3.12 and newer)
+        static constexpr bool hasOwnGIL = PY_VERSION_HEX >= 0x030C0000;
+
+        // Starts size workers with one sub-interpreter each. Python has to be initialized
+        explicit InterpreterPool(size_t size);
+
+        // Finishes all pending tasks and ends the sub-interpreters
+        ~InterpreterPool();
+
+        InterpreterPool(const InterpreterPool& other) = delete;
+        InterpreterPool& operator=(const InterpreterPool& other) = delete;
+
+        [[nodiscard]] size_t size() const noexcept { return m_workers.size(); }
+
+        // Key of the interpreter run by the given worker
+        [[nodiscard]] const detail::InterpreterKey& Key(size_t worker) const;
+
+        // Runs fn on the least busy worker
+        template<typename Fn>
+        auto Submit(Fn&& fn)
+        {
+            return SubmitTo(LeastBusyWorker(), std::forward<Fn>(fn));
+        }
+
+        // Runs fn on the given worker
+        template<typename Fn>
+        auto SubmitTo(size_t worker, Fn&& fn)
+        {
+            using Result = std::invoke_result_t<std::decay_t<Fn>&>;
+            static_assert(!std::is_base_of_v<Object, std::decay_t<Result>>,
+                "InterpreterPool: tasks can not return Objects, return a PinnedObject or a C++ value instead");
+
+            // std::function needs a copyable target. Errors are detached from the objects of the
+            // worker's interpreter, they are rethrown by the future on another thread
+            auto pTask = std::make_shared<std::packaged_task<Result()>>(
+                [fn = std::decay_t<Fn>(std::forward<Fn>(fn))]() mutable -> Result { return detail::DetachErrors(fn); });
+            auto future = pTask->get_future();
+            Post(worker, [pTask]() { (*pTask)(); });
+            return future;
+        }
+
+        // Runs fn on the worker running the interpreter owner, e.g. to use a PinnedObject again
+        template<typename Fn>
+        auto SubmitTo(const detail::InterpreterKey& owner, Fn&& fn)
+        {
+            return SubmitTo(WorkerOf(owner), std::forward<Fn>(fn));
+        }
+
+        // Runs a copy of fn once in every interpreter, e.g. to import modules up front
+        template<typename Fn>
+        auto Broadcast(const Fn& fn)
+        {
+            std::vector<decltype(SubmitTo(size_t{}, fn))> futures;
+            futures.reserve(size());
+            for (size_t worker = 0; worker < size(); ++worker)
+                futures.push_back(SubmitTo(worker, fn));
+            return futures;
+        }
+
+    private:
+        // stops and joins all workers, the calling thread must not hold the GIL
+        void Shutdown() noexcept;
+        void Post(size_t worker, std::function<void()> task);
+        size_t LeastBusyWorker() const noexcept;
+        size_t WorkerOf(const detail::InterpreterKey& owner) const;
+
+        std::vector<std::unique_ptr<detail::PoolWorker>> m_workers;
+    };
+}
+
+#endif // PYCPP_INTERPRETER_POOL_H
@@ -0,0 +1,248 @@
+#pragma once
+#ifndef PYCPP_ITERATOR_H
+#define PYCPP_ITERATOR_H
+
+/*
+    Iterators over Python sequences and iterables. Items are converted to T with python_cast
+    when they are read, nothing is materialized up front.
+
+    SequenceIterator is the random access iterator of List and Tuple. Iterable<T> wraps any
+    iterable object (generators, sets, dict views, files, ...) and walks it with PyIter_Next,
+    so it can be used with range-for and std::ranges algorithms using constant memory:
+
+        for (const auto& line : pycpp::Iterable<std::string>(file))
+            ...
+*/
+
+#include "Python.h"
+#include "Object.h"
+#include "Error.h"
+#include "TypeTraits.h"
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+
+namespace pycpp
+{
+    namespace detail
+    {
+        // Random access iterator over a list or tuple. GetItem returns a borrowed reference (PyList_GetItem or PyTuple_GetItem)
+        template<typename T, PyObject* (*GetItem)(PyObject*, Py_ssize_t)>
+        class SequenceIterator
+        {
+        public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::input_iterator_tag; // items are returned by value
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using reference = T;
+
+            SequenceIterator() noexcept = default;
+
+            SequenceIterator(PyObject* pSequence, Py_ssize_t idx) noexcept
+                : m_pSequence(pSequence), m_idx(idx)
+            {}
+
+            T operator*() const
+            {
+                auto pItem = GetItem(m_pSequence, m_idx);
+                if (!pItem)
+                    Error::ThrowCurrent();
+                return python_cast<T>(pItem);
+            }
+
+            T operator[](difference_type offset) const
+            {
+                return *(*this + offset);
+            }
+
+            SequenceIterator& operator++() noexcept
+            {
+                ++m_idx;
+                return *this;
+            }
+
+            SequenceIterator operator++(int) noexcept
+            {
+                auto copy = *this;
+                ++m_idx;
+                return copy;
+            }
+
+            SequenceIterator& operator--() noexcept
+            {
+                --m_idx;
+                return *this;
+            }
+
+            SequenceIterator operator--(int) noexcept
+            {
+                auto copy = *this;
+                --m_idx;
+                return copy;
+            }
+
+            SequenceIterator& operator+=(difference_type offset) noexcept
+            {
+                m_idx += offset;
+                return *this;
+            }
+
+            SequenceIterator& operator-=(difference_type offset) noexcept
+            {
+                m_idx -= offset;
+                return *this;
+            }
+
+            friend SequenceIterator operator+(SequenceIterator it, difference_type offset) noexcept
+            {
+                return it += offset;
+            }
+
+            friend SequenceIterator operator+(difference_type offset, SequenceIterator it) noexcept
+            {
+                return it += offset;
+            }
+
+            friend SequenceIterator operator-(SequenceIterator it, difference_type offset) noexcept
+            {
+                return it -= offset;
+            }
+
+            friend difference_type operator-(const SequenceIterator& lhs, const SequenceIterator& rhs) noexcept
+            {
+                return lhs.m_idx - rhs.m_idx;
+            }
+
+            friend bool operator==(const SequenceIterator& lhs, const SequenceIterator& rhs) noexcept
+            {
+                return lhs.m_idx == rhs.m_idx;
+            }
+
+            friend std::strong_ordering operator<=>(const SequenceIterator& lhs, const SequenceIterator& rhs) noexcept
+            {
+                return lhs.m_idx <=> rhs.m_idx;
+            }
+
+        private:
+            PyObject* m_pSequence = nullptr;
+            Py_ssize_t m_idx = 0;
+        };
+    }
+
+    /*
+        Single pass input iterator over a Python iterator, compares equal to std::default_sentinel
+        when exhausted. Each item is converted once when the iterator is advanced.
+    */
+    template<typename T>
+    class IterableIterator
+    {
+    public:
+        using iterator_concept = std::input_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = const T&;
+
+        IterableIterator() noexcept = default;
+
+        // Takes ownership of a new reference to a Python iterator
+        explicit IterableIterator(Object iterator)
+            : m_iterator(std::move(iterator))
+        {
+            Next();
+        }
+
+        IterableIterator(const IterableIterator& other) = delete;
+        IterableIterator& operator=(const IterableIterator& other) = delete;
+        IterableIterator(IterableIterator&& other) noexcept = default;
+        IterableIterator& operator=(IterableIterator&& other) noexcept = default;
+
+        const T& operator*() const noexcept
+        {
+            return *m_current;
+        }
+
+        const T* operator->() const noexcept
+        {
+            return &*m_current;
+        }
+
+        IterableIterator& operator++()
+        {
+            Next();
+            return *this;
+        }
+
+        void operator++(int)
+        {
+            Next();
+        }
+
+        friend bool operator==(const IterableIterator& it, std::default_sentinel_t) noexcept
+        {
+            return !it.m_current.has_value();
+        }
+
+    private:
+        void Next()
+        {
+            m_current.reset();
+            Object item = PyIter_Next(m_iterator.get());
+            if (!item)
+            {
+                if (PyErr_Occurred())
+                    Error::ThrowCurrent();
+                return;
+            }
+            m_current.emplace(python_cast<T>(item));
+        }
+
+        Object m_iterator;
+        std::optional<T> m_current;
+    };
+
+    /*
+        Any Python object that can be iterated over. Every call to begin() calls iter() on the
+        object, so whether it can be iterated more than once depends on the object; generators
+        and other iterators can not.
+    */
+    template<typename T>
+    class Iterable : public Object
+    {
+        static_assert(isPythonBaseType_v<T>, "Iterable<T>: T is not a valid PythonBaseType");
+    public:
+        using value_type = T;
+        using iterator = IterableIterator<T>;
+
+        // Take ownership of an existing PyObject which points to an iterable Python object
+        Iterable(PyObject* pIterableObj)
+            :Object(pIterableObj)
+        {}
+
+        Iterable(const Object& other)
+            :Object(other)
+        {}
+
+        Iterable(const Iterable& other) = default;
+        Iterable& operator=(const Iterable& other) = default;
+        Iterable(Iterable&& other) noexcept = default;
+        Iterable& operator=(Iterable&& other) noexcept = default;
+
+        [[nodiscard]] iterator begin() const
+        {
+            Object iterator = PyObject_GetIter(m_pObject);
+            if (!iterator)
+                Error::ThrowCurrent();
+            return IterableIterator<T>(std::move(iterator));
+        }
+
+        [[nodiscard]] std::default_sentinel_t end() const noexcept
+        {
+            return std::default_sentinel;
+        }
+    };
+}
+
+#endif // PYCPP_ITERATOR_H
@@ -5,7 +5,10 @@
 #include "TypeTraits.h"
 #include "Object.h"
 #include "Error.h"
+#include "BulkConversion.h"
+#include "Iterator.h"
 #include <initializer_list>
+#include <iterator>
 #include <vector>
 #include <algorithm>
 
@@ -46,16 +49,15 @@ namespace pycpp
             {
                 auto pItem = PyList_GetItem(m_list.get(), m_idx);
                 if (!pItem)
-                    throw Error();
+                    Error::ThrowCurrent();
                 return python_cast<T>(pItem);
             }
 
             Reference& operator=(const T& val)
             {
-                auto pyObj = ToObject(val);
-                Py_INCREF(pyObj.get()); // PyList_SetItem steals a reference
-                if (PyList_SetItem(m_list.get(), m_idx, pyObj.get()) == -1)
-                    throw Error();
+                // PyList_SetItem steals the new reference, even if it fails
+                if (PyList_SetItem(m_list.get(), m_idx, detail::NewReference(val)) == -1)
+                    Error::ThrowCurrent();
                 return *this;
             }
 
@@ -65,47 +67,27 @@ namespace pycpp
         };
 
     public:
+        using value_type = T;
+        using const_iterator = detail::SequenceIterator<T, PyList_GetItem>;
+        using iterator = const_iterator;
+
         // Default constructor will create a new List with size 0
         // analog to myList = [] or myList = List() in Python
         List()
         {
             m_pObject = PyList_New(0);
             if (!m_pObject)
-                throw Error();
+                Error::ThrowCurrent();
         }
 
         List(const std::initializer_list<T>& iList)
-        {
-            m_pObject = PyList_New(iList.size());
-            if (!m_pObject)
-                throw Error();
-            size_t idx = 0;
-            for (const auto& elem : iList)
-            {
-                auto newElem = ToObject(elem);
-                Py_INCREF(newElem.get()); // PyList_SetItem steals a ref..
-                if (PyList_SetItem(m_pObject, idx, newElem.get()) == -1)
-                    throw Error();
-                ++idx;
-            }
-        }
+            : Object(detail::BuildList(iList.begin(), iList.size()))
+        {}
 
         template<typename Container, typename val_t = typename Container::value_type, std::enable_if_t<isPythonBaseType_v<val_t>, int> = 0>
         List(const Container& container)
-        {
-            m_pObject = PyList_New(container.size());
-            if (!m_pObject)
-                throw Error();
-            auto idx = 0;
-            std::for_each(container.begin(), container.end(), [&](const auto& elem)
-                {
-                    auto newElem = ToObject(elem);
-                    Py_INCREF(newElem.get()); // PyList_SetItem steals a ref..
-                    if (PyList_SetItem(m_pObject, idx, newElem.get()) == -1)
-                        throw Error();
-                    ++idx;
-                });
-        }
+            : Object(detail::BuildList(std::begin(container), static_cast<size_t>(std::size(container))))
+        {}
 
         // Take ownership of an existing PyObject which points to a Python List or subtype of List
         // Will throw Error if object pointed to by PyObject* is not of List type
@@ -159,6 +141,17 @@ namespace pycpp
             return PyList_Size(m_pObject); // can this fail in any way?
         }
 
+        // Items are converted when dereferenced, see SequenceIterator
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+            return const_iterator(m_pObject, 0);
+        }
+
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+            return const_iterator(m_pObject, static_cast<Py_ssize_t>(size()));
+        }
+
         Reference operator[](size_t idx)
         {
             return Reference(*this, idx);
@@ -168,7 +161,7 @@ namespace pycpp
         {
             auto pItem = PyList_GetItem(m_pObject, idx);
             if (!pItem)
-                throw Error();
+                Error::ThrowCurrent();
             return python_cast<T>(pItem);
         }
 
@@ -177,19 +170,19 @@ namespace pycpp
             const auto py_val = ToObject(val);
 
             if (PyList_Append(m_pObject, py_val.get()) == -1)
-                throw Error();
+                Error::ThrowCurrent();
         }
 
         void append(const Object& pyObj)
         {
             if (PyList_Append(m_pObject, pyObj.get()) == -1)
-                throw Error();
+                Error::ThrowCurrent();
         }
 
         void append(PyObject* pPyObj)
         {
             if (PyList_Append(m_pObject, pPyObj) == -1)
-                throw Error();
+                Error::ThrowCurrent();
         }
 
         void insert(size_t index, const T& val)
@@ -197,19 +190,19 @@ namespace pycpp
             const auto py_val = ToObject(val);
 
             if (PyList_Insert(m_pObject, index, py_val.get()) == -1)
-                throw Error();
+                Error::ThrowCurrent();
         }
 
         void insert(size_t index, const Object& pyObj)
         {
             if (PyList_Insert(m_pObject, index, pyObj.get()) == -1)
-                throw Error();
+                Error::ThrowCurrent();
         }
 
         void insert(size_t index, PyObject* pPyObj)
         {
             if (PyList_Insert(m_pObject, index, pPyObj) == -1)
-                throw Error();
+                Error::ThrowCurrent();
         }
 
         List slice(size_t lowIdx, size_t highIdx) const
@@ -220,30 +213,29 @@ namespace pycpp
         void sort()
         {
             if (PyList_Sort(m_pObject) == -1)
-                throw Error();
+                Error::ThrowCurrent();
         }
 
         void reverse()
         {
             if (PyList_Reverse(m_pObject) == -1)
-                throw Error();
+                Error::ThrowCurrent();
         }
 
-        // I did not seem to find any way to access the raw data of the PyList object
-        std::vector<T> ToVector()
+        // Exact float and small int items are unboxed in bulk, see BulkConversion.h
+        std::vector<T> ToVector() const
         {
             std::vector<T> ret;
-            ret.reserve((size()));
-            for (size_t idx = 0; idx < size(); ++idx)
-            {
-                auto pItem = PyList_GetItem(m_pObject, idx);
-                if (!pItem)
-                    throw Error();
-                ret.push_back(python_cast<T>(pItem));
-            }
+            detail::ListToVector(m_pObject, ret);
             return ret;
         }
 
+        // Same as above, but reuses the memory of out
+        void ToVector(std::vector<T>& out) const
+        {
+            detail::ListToVector(m_pObject, out);
+        }
+
     private:
     };
 
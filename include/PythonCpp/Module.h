@@ -0,0 +1,106 @@
+#pragma once
+#ifndef PYCPP_MODULE_H
+#define PYCPP_MODULE_H
+
+/*
+    Cached module imports. ImportModule goes through PyImport_ImportModule on every call, which is
+    a sys.modules lookup plus import lock traffic even for modules that are loaded long since.
+    ModuleCache imports every module once per interpreter and returns the cached module after:
+
+        auto json = pycpp::ModuleCache::Import("json");
+
+    LazyModule is meant to be a static at the call site. It imports nothing until it is first
+    used, from then on it costs a cached pointer lookup:
+
+        static pycpp::LazyModule s_numpy("numpy");
+        pycpp::Callable array = s_numpy.GetAttribute("array");
+
+    ModulePrewarm imports heavy modules on a background thread at startup, into the cache of the
+    main interpreter, so the first request doesn't pay seconds of import time. A request that
+    needs a module while it is still being imported waits for that import (Python's module lock)
+    instead of starting another one:
+
+        pycpp::ModulePrewarm prewarm({ "numpy", "mypackage.model" });
+        ...
+        prewarm.Wait(); // optional, rethrows the first import error
+
+    The cache holds strong references, so modules stay cached when they are removed from
+    sys.modules or reloaded. The cache of an interpreter is released before it is finalized.
+*/
+
+#include "Python.h"
+#include "Defines.h"
+#include "Object.h"
+#include "Error.h"
+#include "Result.h"
+#include "AttributeName.h"
+#include "Interpreter.h"
+#include <exception>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace pycpp
+{
+    class PYCPP_API ModuleCache
+    {
+    public:
+        // The module, imported on first use in the current interpreter
+        static Object Import(std::string_view name);
+
+        // Same as Import, but failures are returned instead of thrown, see Result.h. Failed
+        // imports are not cached
+        [[nodiscard]] static Result<Object> TryImport(std::string_view name);
+    };
+
+    class PYCPP_API LazyModule
+    {
+    public:
+        explicit LazyModule(std::string name);
+
+        // The module, imported on first use in the current interpreter, see ModuleCache
+        [[nodiscard]] Object Get() const;
+
+        Object GetAttribute(const char* attribute) const;
+        Object GetAttribute(const std::string& attribute) const;
+        Object GetAttribute(const AttributeName& attribute) const;
+
+        [[nodiscard]] const std::string& Name() const noexcept;
+
+    private:
+        PyObject* Module() const;
+
+        std::string m_name;
+        detail::InterpreterLocalRef m_module;
+    };
+
+    class PYCPP_API ModulePrewarm
+    {
+    public:
+        // Starts importing modules in the given order. Keeps the interpreter open until done
+        explicit ModulePrewarm(std::vector<std::string> modules);
+
+        // Waits for the imports, errors are dropped
+        ~ModulePrewarm();
+
+        ModulePrewarm(const ModulePrewarm& other) = delete;
+        ModulePrewarm& operator=(const ModulePrewarm& other) = delete;
+
+        // Waits for the imports and throws the first import error, if any. The other modules are
+        // imported regardless of errors
+        void Wait();
+
+    private:
+        void Run() noexcept;
+        void Join();
+
+        InterpreterHandle m_handle;
+        std::vector<std::string> m_modules;
+        std::exception_ptr m_pError;
+        std::thread m_thread;
+    };
+}
+
+#endif // PYCPP_MODULE_H
@@ -16,6 +16,11 @@
 
 namespace pycpp
 {
+    class AttributeName;
+
+    template<typename T>
+    class Result;
+
     class PYCPP_API Object
     {
     public:
@@ -41,6 +46,12 @@ namespace pycpp
 
         [[nodiscard]] PyObject* get() const noexcept;
 
+        // Gives up ownership of the reference and returns it, like std::unique_ptr::release (Release
+        // drops the reference instead). Meant for C API functions that steal a reference
+        // (PyTuple_SET_ITEM, PyList_SetItem, ...), so the reference is handed over instead of being
+        // increfed for the callee and decrefed here
+        [[nodiscard]] PyObject* ReleaseOwnership() noexcept;
+
         [[nodiscard]] PyObject* operator->() const noexcept;
 
         [[nodiscard]] operator bool() const noexcept;
@@ -52,11 +63,20 @@ namespace pycpp
         // In the worst case, the returned string is null
         [[nodiscard]] std::string StringRepr() noexcept;
 
-        [[nodiscard]] bool HasAttribute(const char* attribute) noexcept;
-        [[nodiscard]] bool HasAttribute(const std::string& str) noexcept;
+        // AttributeName (PYCPP_NAME) attributes are looked up with cached interned str objects, names
+        // given as strings with a temporary str, see AttributeName
+        [[nodiscard]] bool HasAttribute(const char* attribute) const noexcept;
+        [[nodiscard]] bool HasAttribute(const std::string& str) const noexcept;
+        [[nodiscard]] bool HasAttribute(const AttributeName& attribute) const noexcept;
+
+        Object GetAttribute(const char* attribute) const;
+        Object GetAttribute(const std::string& str) const;
+        Object GetAttribute(const AttributeName& attribute) const;
 
-        Object GetAttribute(const char* attribute);
-        Object GetAttribute(const std::string& str);
+        // Same as GetAttribute, but failures (e.g. a missing attribute) are returned instead of thrown, see Result.h
+        [[nodiscard]] Result<Object> TryGetAttribute(const char* attribute) const;
+        [[nodiscard]] Result<Object> TryGetAttribute(const std::string& str) const;
+        [[nodiscard]] Result<Object> TryGetAttribute(const AttributeName& attribute) const;
 
         [[nodiscard]] static Object BorrowedRef(PyObject* pPyObj);
 
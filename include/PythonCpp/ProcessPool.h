@@ -0,0 +1,346 @@
+#pragma once
+#ifndef PYCPP_PROCESS_POOL_H
+#define PYCPP_PROCESS_POOL_H
+
+/*
+    Pool of forked worker processes, each running its own copy of the interpreter, so CPU bound
+    Python code scales with the number of cores instead of being limited by one GIL. The workers
+    are forked from the current interpreter: everything imported before the pool is created is
+    shared copy-on-write and does not have to be imported again.
+
+        auto handle = pycpp::Interpreter::Handle();
+        pycpp::ImportModule("mypackage.model");   // paid once, inherited by all workers
+        pycpp::ProcessPool pool(8);
+        std::future<double> score = pool.Submit<double>("mypackage.model.score", samples);
+
+    Functions are named by their dotted path ("module.function" or "module.Class.method") and
+    resolved once per worker. Calls and results travel through one pair of shared-memory ring
+    buffers (POSIX shm) per worker in a small binary format: None, bool, integers, floats, str,
+    bytes and contiguous buffers. Buffers (std::vector/std::span of arithmetic types on the C++
+    side, anything implementing the buffer protocol on the Python side) are copied as raw memory
+    and arrive as memoryview with the original format, nothing is pickled. Results are converted
+    to T on a reader thread of the pool, so waiting for them does not need the GIL.
+
+    The pool must be created by the thread holding the GIL while no other thread uses Python,
+    since fork only duplicates the calling thread. On Linux the workers are killed when the
+    thread that created the pool exits (PR_SET_PDEATHSIG tracks the thread, not the process), so
+    create the pool on a thread that lives at least as long as the pool. POSIX only.
+*/
+
+#ifndef _WIN32
+
+#include "Python.h"
+#include "Defines.h"
+#include "Error.h"
+#include "Buffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pycpp
+{
+    namespace detail
+    {
+        struct ProcessWorker;
+
+        enum class WireTag : uint8_t
+        {
+            None,
+            Bool,
+            Int,
+            Float,
+            Str,
+            Bytes,
+            Buffer,
+            Error
+        };
+
+        // Appends values in the wire format of ProcessPool to a byte vector
+        class WireWriter
+        {
+        public:
+            explicit WireWriter(std::vector<std::byte>& out) noexcept
+                : m_out(out)
+            {}
+
+            template<typename T>
+            void Raw(const T& value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                Bytes(&value, sizeof(T));
+            }
+
+            void Bytes(const void* pData, size_t size)
+            {
+                const auto offset = m_out.size();
+                m_out.resize(offset + size);
+                if (size > 0)
+                    std::memcpy(m_out.data() + offset, pData, size);
+            }
+
+            void Tag(WireTag tag)
+            {
+                Raw(tag);
+            }
+
+            void String(WireTag tag, std::string_view str)
+            {
+                Tag(tag);
+                Raw(static_cast<uint64_t>(str.size()));
+                Bytes(str.data(), str.size());
+            }
+
+            void Buffer(std::string_view format, size_t itemSize, const void* pData, size_t size)
+            {
+                Tag(WireTag::Buffer);
+                Raw(static_cast<uint32_t>(format.size()));
+                Bytes(format.data(), format.size());
+                Raw(static_cast<uint64_t>(itemSize));
+                Raw(static_cast<uint64_t>(size));
+                Bytes(pData, size);
+            }
+
+        private:
+            std::vector<std::byte>& m_out;
+        };
+
+        // Reads values written by WireWriter, throws Error if the message is truncated
+        class PYCPP_API WireReader
+        {
+        public:
+            explicit WireReader(std::span<const std::byte> data) noexcept
+                : m_data(data)
+            {}
+
+            template<typename T>
+            T Raw()
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                T value;
+                std::memcpy(&value, Bytes(sizeof(T)), sizeof(T));
+                return value;
+            }
+
+            const std::byte* Bytes(size_t size);
+
+            WireTag Tag()
+            {
+                return Raw<WireTag>();
+            }
+
+            // Contents of a Str, Bytes or Error value whose tag was already read
+            std::string_view String();
+
+            struct BufferData
+            {
+                std::string_view format;
+                size_t itemSize = 0;
+                const std::byte* pData = nullptr;
+                size_t size = 0;
+            };
+
+            // Buffer value whose tag was already read
+            BufferData Buffer();
+
+            [[nodiscard]] bool AtEnd() const noexcept { return m_offset == m_data.size(); }
+
+        private:
+            std::span<const std::byte> m_data;
+            size_t m_offset = 0;
+        };
+
+        template<typename T>
+        struct isVectorOfArithmetic : std::false_type
+        {};
+
+        template<typename T>
+        struct isVectorOfArithmetic<std::vector<T>> : std::is_arithmetic<T>
+        {};
+
+        template<typename T>
+        struct isSpanOfArithmetic : std::false_type
+        {};
+
+        template<typename T, size_t N>
+        struct isSpanOfArithmetic<std::span<T, N>> : std::is_arithmetic<std::remove_cv_t<T>>
+        {};
+
+        template<typename T>
+        constexpr bool isWireArgument = std::is_arithmetic_v<T> || std::is_same_v<T, std::nullptr_t> ||
+            std::is_convertible_v<const T&, std::string_view> || isVectorOfArithmetic<T>::value || isSpanOfArithmetic<T>::value;
+
+        template<typename T>
+        void WriteArgument(WireWriter& writer, const T& value)
+        {
+            if constexpr (std::is_same_v<T, std::nullptr_t>)
+                writer.Tag(WireTag::None);
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                writer.Tag(WireTag::Bool);
+                writer.Raw(static_cast<uint8_t>(value));
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                static_assert(sizeof(T) < sizeof(int64_t) || std::is_signed_v<T>,
+                    "ProcessPool: 64 bit unsigned integers are not supported as arguments");
+                writer.Tag(WireTag::Int);
+                writer.Raw(static_cast<int64_t>(value));
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                writer.Tag(WireTag::Float);
+                writer.Raw(static_cast<double>(value));
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+                writer.String(WireTag::Str, std::string_view(value));
+            else
+            {
+                using Item = std::remove_cv_t<typename T::value_type>;
+                writer.Buffer(BufferFormat_v<Item>, sizeof(Item), value.data(), value.size() * sizeof(Item));
+            }
+        }
+
+        // Throws if the value is an error sent by the worker
+        PYCPP_API void ThrowIfError(WireTag tag, WireReader& reader);
+
+        // Reads a result and converts it to T
+        template<typename T>
+        T ReadResult(WireReader& reader)
+        {
+            const auto tag = reader.Tag();
+            ThrowIfError(tag, reader);
+
+            if constexpr (std::is_void_v<T>)
+                return;
+            else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+            {
+                int64_t value = 0;
+                if (tag == WireTag::Bool)
+                    value = reader.Raw<uint8_t>() != 0;
+                else if (tag == WireTag::Int)
+                    value = reader.Raw<int64_t>();
+                else
+                    throw Error("ProcessPool: result is not an int");
+                // the same check python_cast does for results of the interpreter itself
+                if (!std::in_range<T>(value))
+                    throw OverflowError("ProcessPool: result " + std::to_string(value) + " does not fit into the result type");
+                return static_cast<T>(value);
+            }
+            else if constexpr (std::is_same_v<T, bool> || std::is_floating_point_v<T>)
+            {
+                if (tag == WireTag::Bool)
+                    return static_cast<T>(reader.Raw<uint8_t>() != 0);
+                if (tag == WireTag::Int)
+                    return static_cast<T>(reader.Raw<int64_t>());
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    if (tag == WireTag::Float)
+                        return static_cast<T>(reader.Raw<double>());
+                }
+                throw Error("ProcessPool: result is not a number");
+            }
+            else if constexpr (std::is_same_v<T, std::string>)
+            {
+                if (tag != WireTag::Str && tag != WireTag::Bytes)
+                    throw Error("ProcessPool: result is not a str or bytes");
+                return std::string(reader.String());
+            }
+            else if constexpr (isVectorOfArithmetic<T>::value)
+            {
+                using Item = typename T::value_type;
+                if (tag != WireTag::Buffer)
+                    throw Error("ProcessPool: result does not support the buffer protocol");
+                const auto buffer = reader.Buffer();
+
+                const std::string format(buffer.format);
+                Py_buffer view{};
+                view.format = const_cast<char*>(format.c_str());
+                view.itemsize = static_cast<Py_ssize_t>(buffer.itemSize);
+                CheckBufferFormat(view, BufferKindOf<Item>(), sizeof(Item));
+
+                T result(buffer.size / sizeof(Item));
+                if (!result.empty())
+                    std::memcpy(result.data(), buffer.pData, result.size() * sizeof(Item));
+                return result;
+            }
+            else
+                static_assert(sizeof(T) == 0, "ProcessPool: unsupported result type");
+        }
+    }
+
+    class PYCPP_API ProcessPool
+    {
+    public:
+        // Forks size workers from the current interpreter. Each worker gets two rings of
+        // ringCapacity bytes; a single call or result has to fit into half a ring
+        explicit ProcessPool(size_t size, size_t ringCapacity = 4 << 20);
+
+        // Finishes all submitted calls and waits for the workers to exit
+        ~ProcessPool();
+
+        ProcessPool(const ProcessPool& other) = delete;
+        ProcessPool& operator=(const ProcessPool& other) = delete;
+
+        [[nodiscard]] size_t size() const noexcept { return m_workers.size(); }
+
+        // Calls the function with the given dotted path in the least busy worker. The result is
+        // converted to T: void, bool, arithmetic types, std::string or std::vector of arithmetic
+        // types (from any buffer). Python exceptions are rethrown by the future as Error
+        template<typename T = void, typename... Args>
+        std::future<T> Submit(std::string_view function, const Args&... args)
+        {
+            static_assert((detail::isWireArgument<Args> && ...),
+                "ProcessPool: arguments have to be None, bool, numbers, strings or vectors/spans of arithmetic types");
+
+            std::vector<std::byte> message;
+            detail::WireWriter writer(message);
+            writer.String(detail::WireTag::Str, function);
+            writer.Raw(static_cast<uint32_t>(sizeof...(Args)));
+            (detail::WriteArgument(writer, args), ...);
+
+            auto pPromise = std::make_shared<std::promise<T>>();
+            auto future = pPromise->get_future();
+            Post(message, [pPromise](detail::WireReader* pReader, std::exception_ptr exception)
+                {
+                    try
+                    {
+                        if (exception)
+                            std::rethrow_exception(exception);
+                        if constexpr (std::is_void_v<T>)
+                        {
+                            detail::ReadResult<void>(*pReader);
+                            pPromise->set_value();
+                        }
+                        else
+                            pPromise->set_value(detail::ReadResult<T>(*pReader));
+                    }
+                    catch (...)
+                    {
+                        pPromise->set_exception(std::current_exception());
+                    }
+                });
+            return future;
+        }
+
+    private:
+        // called with the result, or with an exception if the worker is gone
+        using Completion = std::function<void(detail::WireReader*, std::exception_ptr)>;
+
+        void Post(const std::vector<std::byte>& message, Completion completion);
+
+        std::vector<std::unique_ptr<detail::ProcessWorker>> m_workers;
+    };
+}
+
+#endif // _WIN32
+
+#endif // PYCPP_PROCESS_POOL_H
@@ -11,12 +11,28 @@
 #include "Python.h"
 #include "Object.h"
 #include "Error.h"
+#include "Result.h"
 #include "TypeTraits.h"
 #include "Interpreter.h"
 #include "Sys.h"
+#include "Iterator.h"
 #include "List.h"
 #include "Tuple.h"
+#include "Dict.h"
+#include "Bytes.h"
+#include "Record.h"
+#include "Columns.h"
+#include "Arguments.h"
+#include "AttributeName.h"
+#include "Buffer.h"
 #include "Callable.h"
+#include "Function.h"
+#include "Class.h"
 #include "Utilities.h"
+#include "Module.h"
+#include "InterpreterPool.h"
+#include "Executor.h"
+#include "Async.h"
+#include "ProcessPool.h"
 
 #endif // PYTHON_CPP_H
@@ -0,0 +1,271 @@
+#pragma once
+#ifndef PYCPP_RECORD_H
+#define PYCPP_RECORD_H
+
+/*
+    Records are plain C++ structs described at compile time with PYCPP_RECORD, so they can be
+    converted like any other PythonBaseType (ToObject, python_cast, arguments, List<T>, ...):
+
+        struct Trade
+        {
+            std::string symbol;
+            double price;
+            long quantity;
+        };
+        PYCPP_RECORD(Trade, symbol, price, quantity)
+
+        pycpp::List<Trade> trades(tradeVector);
+        auto best = pycpp::python_cast<Trade>(pickBest.Invoke(trades));
+
+    In Python a record is an instance of a struct sequence type (the kind of type os.stat_result
+    and time.struct_time are), which behaves like a namedtuple: trade.price, trade[1] and tuple
+    unpacking all work. The type is created once per interpreter and named pycpp.<struct name>.
+    Fields are stored and read by position, there is no per field name lookup or hashing.
+
+    The reverse conversion accepts any tuple with the right number of items (including the
+    struct sequence and namedtuples) and reads it by position. Other objects (dataclasses,
+    __slots__ classes, ...) are read by attribute with interned names.
+
+    PYCPP_RECORD has to be used at global namespace scope, the struct has to be default
+    constructible and every field type has to be a PythonBaseType (which includes records).
+*/
+
+#include "Python.h"
+#include "Defines.h"
+#include "TypeTraits.h"
+#include "Object.h"
+#include "Error.h"
+#include "Result.h"
+#include "Interpreter.h"
+#include "Arguments.h"
+#include "AttributeName.h"
+#include "BulkConversion.h"
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pycpp
+{
+    namespace detail
+    {
+        // Name without namespaces, "geo::Point" -> "Point"
+        constexpr const char* UnqualifiedName(const char* pName) noexcept
+        {
+            const char* pStart = pName;
+            for (const char* pChar = pName; *pChar; ++pChar)
+            {
+                if (*pChar == ':')
+                    pStart = pChar + 1;
+            }
+            return pStart;
+        }
+
+        // Keeps the names a struct sequence type refers to alive
+        class PYCPP_API RecordDescription
+        {
+        public:
+            RecordDescription(const char* pName, std::span<const char* const> fieldNames);
+
+            RecordDescription(const RecordDescription& other) = delete;
+            RecordDescription& operator=(const RecordDescription& other) = delete;
+
+            // New struct sequence type for the current interpreter
+            [[nodiscard]] Object NewType();
+
+        private:
+            std::string m_name;
+            std::vector<PyStructSequence_Field> m_fields;
+            PyStructSequence_Desc m_desc{};
+        };
+
+        template<typename T>
+        constexpr size_t recordSize = std::tuple_size_v<std::remove_const_t<decltype(RecordTraits<T>::fields)>>;
+
+        // Borrowed struct sequence type of T for the current interpreter
+        template<typename T>
+        PyTypeObject* RecordType()
+        {
+            static const InterpreterLocalRef s_type;
+            return reinterpret_cast<PyTypeObject*>(s_type.Get([]
+                {
+                    static RecordDescription s_description(RecordTraits<T>::name, RecordTraits<T>::names);
+                    return s_description.NewType();
+                }));
+        }
+
+        // Borrowed array of the interned field names of T for the current interpreter, kept in a tuple
+        // so reading objects by attribute does not look up the names again for every field
+        template<typename T>
+        PyObject* const* RecordFieldNames()
+        {
+            static const InterpreterLocalRef s_names;
+            PyObject* pNames = s_names.Get([]
+                {
+                    Object names = PyTuple_New(static_cast<Py_ssize_t>(recordSize<T>));
+                    if (!names)
+                        Error::ThrowCurrent();
+                    for (size_t idx = 0; idx < recordSize<T>; ++idx)
+                    {
+                        PyObject* pName = InternName(RecordTraits<T>::names[idx]);
+                        Py_INCREF(pName);
+                        PyTuple_SET_ITEM(names.get(), static_cast<Py_ssize_t>(idx), pName);
+                    }
+                    return names;
+                });
+            return &PyTuple_GET_ITEM(pNames, 0);
+        }
+
+        template<typename T>
+        Object RecordToObject(const T& record)
+        {
+            Object result = PyStructSequence_New(RecordType<T>());
+            if (!result)
+                Error::ThrowCurrent();
+            // if a conversion throws, result is released with the remaining slots still being null, which is fine
+            std::apply([&](auto... members)
+                {
+                    Py_ssize_t idx = 0;
+                    ((PyStructSequence_SetItem(result.get(), idx++, NewReference(record.*members))), ...);
+                }, RecordTraits<T>::fields);
+            return result;
+        }
+
+        template<typename T>
+        Result<T> TryRecordFromObject(PyObject* pPyObj)
+        {
+            constexpr auto size = recordSize<T>;
+            const bool isTuple = PyTuple_Check(pPyObj) != 0;
+            if (isTuple && PyTuple_Size(pPyObj) != static_cast<Py_ssize_t>(size))
+            {
+                PyErr_Format(PyExc_TypeError, "%s: expected %zu items, got %zd", RecordTraits<T>::name, size, PyTuple_Size(pPyObj));
+                return ErrorInfo::Fetch();
+            }
+
+            PyObject* const* ppNames = nullptr;
+            if (!isTuple)
+            {
+                try
+                {
+                    ppNames = RecordFieldNames<T>();
+                }
+                catch (const Error& e)
+                {
+                    return ErrorInfo(e, std::current_exception());
+                }
+            }
+
+            T record{};
+            std::optional<ErrorInfo> error;
+            size_t idx = 0;
+            const auto readField = [&](auto member) -> bool
+                {
+                    using Field = std::remove_cv_t<std::remove_reference_t<decltype(record.*member)>>;
+                    static_assert(!isStringView_v<Field>, "Record: std::string_view fields would point into temporary objects, use std::string");
+                    PyObject* pItem = nullptr;
+                    Object attribute;
+                    if (isTuple)
+                        pItem = PyTuple_GetItem(pPyObj, static_cast<Py_ssize_t>(idx));
+                    else
+                    {
+                        attribute = Object(PyObject_GetAttr(pPyObj, ppNames[idx]));
+                        pItem = attribute.get();
+                    }
+                    ++idx;
+                    if (!pItem)
+                    {
+                        error = ErrorInfo::Fetch();
+                        return false;
+                    }
+                    auto value = try_python_cast<Field>(pItem);
+                    if (!value)
+                    {
+                        error = value.error();
+                        return false;
+                    }
+                    record.*member = std::move(*value);
+                    return true;
+                };
+            std::apply([&](auto... members) { (readField(members) && ...); }, RecordTraits<T>::fields);
+            if (error)
+                return std::move(*error);
+            return record;
+        }
+
+        template<typename T>
+        struct ArgConverter<T, typename std::enable_if_t<isRecord_v<T>>>
+        {
+            constexpr static bool borrowed = false;
+
+            static PyObject* Convert(const T& record)
+            {
+                return RecordToObject(record).ReleaseOwnership();
+            }
+        };
+    }
+}
+
+// Helpers for PYCPP_RECORD, applying m(t, field) to every field
+#define PYCPP_DETAIL_EXPAND(x) x
+#define PYCPP_DETAIL_FE_1(m, t, x) m(t, x)
+#define PYCPP_DETAIL_FE_2(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_1(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_3(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_2(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_4(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_3(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_5(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_4(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_6(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_5(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_7(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_6(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_8(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_7(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_9(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_8(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_10(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_9(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_11(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_10(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_12(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_11(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_13(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_12(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_14(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_13(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_15(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_14(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_16(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_15(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_17(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_16(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_18(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_17(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_19(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_18(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_20(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_19(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_21(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_20(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_22(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_21(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_23(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_22(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_24(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_23(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_25(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_24(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_26(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_25(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_27(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_26(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_28(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_27(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_29(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_28(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_30(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_29(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_31(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_30(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_FE_32(m, t, x, ...) m(t, x), PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_FE_31(m, t, __VA_ARGS__))
+#define PYCPP_DETAIL_GET_FE( \
+    _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, \
+    _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, \
+    name, ...) name
+#define PYCPP_DETAIL_FOR_EACH(m, t, ...) \
+    PYCPP_DETAIL_EXPAND(PYCPP_DETAIL_GET_FE(__VA_ARGS__, \
+        PYCPP_DETAIL_FE_32, PYCPP_DETAIL_FE_31, PYCPP_DETAIL_FE_30, PYCPP_DETAIL_FE_29, PYCPP_DETAIL_FE_28, PYCPP_DETAIL_FE_27, PYCPP_DETAIL_FE_26, PYCPP_DETAIL_FE_25, \
+        PYCPP_DETAIL_FE_24, PYCPP_DETAIL_FE_23, PYCPP_DETAIL_FE_22, PYCPP_DETAIL_FE_21, PYCPP_DETAIL_FE_20, PYCPP_DETAIL_FE_19, PYCPP_DETAIL_FE_18, PYCPP_DETAIL_FE_17, \
+        PYCPP_DETAIL_FE_16, PYCPP_DETAIL_FE_15, PYCPP_DETAIL_FE_14, PYCPP_DETAIL_FE_13, PYCPP_DETAIL_FE_12, PYCPP_DETAIL_FE_11, PYCPP_DETAIL_FE_10, PYCPP_DETAIL_FE_9, \
+        PYCPP_DETAIL_FE_8, PYCPP_DETAIL_FE_7, PYCPP_DETAIL_FE_6, PYCPP_DETAIL_FE_5, PYCPP_DETAIL_FE_4, PYCPP_DETAIL_FE_3, PYCPP_DETAIL_FE_2, PYCPP_DETAIL_FE_1)(m, t, __VA_ARGS__))
+
+#define PYCPP_DETAIL_RECORD_MEMBER(type, field) &type::field
+#define PYCPP_DETAIL_RECORD_NAME(type, field) #field
+
+// Describes the fields of struct type for the conversion to and from Python, see above
+#define PYCPP_RECORD(type, ...) \
+    template<> \
+    struct pycpp::RecordTraits<type> \
+    { \
+        static constexpr const char* name = ::pycpp::detail::UnqualifiedName(#type); \
+        static constexpr auto fields = std::make_tuple(PYCPP_DETAIL_FOR_EACH(PYCPP_DETAIL_RECORD_MEMBER, type, __VA_ARGS__)); \
+        static constexpr const char* names[] = { PYCPP_DETAIL_FOR_EACH(PYCPP_DETAIL_RECORD_NAME, type, __VA_ARGS__) }; \
+    };
+
+#endif // PYCPP_RECORD_H
@@ -0,0 +1,160 @@
+#pragma once
+#ifndef PYCPP_RESULT_H
+#define PYCPP_RESULT_H
+
+/*
+    Result<T> holds either a value or the ErrorInfo of a failed call, for code paths where
+    failures are expected and unwinding an exception would cost more than the call itself:
+
+        if (auto value = pycpp::try_python_cast<long>(obj))
+            sum += *value;
+        else if (!value.error().Matches(PyExc_TypeError))
+            value.error().Throw();
+
+    The Try/try_ functions report Python exceptions only through their Result. The throwing
+    functions of the library are built on top of them, value() throws the same Error subclass
+    the throwing function would have thrown. ErrorInfo holds the Python exception the same way
+    Error does, so the same rules apply to passing it to other threads.
+*/
+
+#include "Python.h"
+#include "Defines.h"
+#include "Object.h"
+#include "Error.h"
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace pycpp
+{
+    class PYCPP_API ErrorInfo
+    {
+    public:
+        // Takes over the current Python exception
+        [[nodiscard]] static ErrorInfo Fetch();
+
+        // Error that is not a Python exception, pMessage has to outlive the ErrorInfo (e.g. a literal)
+        explicit ErrorInfo(const char* pMessage) noexcept;
+
+        // Error that was thrown as pError, Throw rethrows it with its original type and message
+        ErrorInfo(const Error& error, std::exception_ptr pError) noexcept;
+
+        ~ErrorInfo();
+
+        ErrorInfo(const ErrorInfo& other) noexcept;
+        ErrorInfo& operator=(const ErrorInfo& other) noexcept;
+        ErrorInfo(ErrorInfo&& other) noexcept;
+        ErrorInfo& operator=(ErrorInfo&& other) noexcept;
+
+        // True if the Python exception is an instance of pExceptionType (e.g. PyExc_KeyError)
+        [[nodiscard]] bool Matches(PyObject* pExceptionType) const noexcept;
+
+        // Borrowed type of the Python exception, nullptr for other errors
+        [[nodiscard]] PyObject* Type() const noexcept;
+
+        // Sets the exception as the current Python exception, e.g. to return it to Python
+        void Restore() const noexcept;
+
+        // Throws the error as the matching Error subclass, see Error::ThrowCurrent
+        [[noreturn]] void Throw() const;
+
+    private:
+        ErrorInfo() noexcept = default;
+
+        std::shared_ptr<detail::ErrorState> m_pState;
+        std::exception_ptr m_pError;
+        const char* m_pMessage = nullptr;
+    };
+
+    template<typename T>
+    class [[nodiscard]] Result
+    {
+        static_assert(!std::is_reference_v<T> && !std::is_void_v<T>, "Result: T has to be a value type");
+    public:
+        Result(T value) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : m_value(std::in_place_index<0>, std::move(value))
+        {}
+
+        Result(ErrorInfo error) noexcept
+            : m_value(std::in_place_index<1>, std::move(error))
+        {}
+
+        [[nodiscard]] bool has_value() const noexcept
+        {
+            return m_value.index() == 0;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return has_value();
+        }
+
+        // The value, throws the error if there is none
+        [[nodiscard]] T& value() &
+        {
+            if (!has_value())
+                error().Throw();
+            return *std::get_if<0>(&m_value);
+        }
+
+        [[nodiscard]] const T& value() const&
+        {
+            if (!has_value())
+                error().Throw();
+            return *std::get_if<0>(&m_value);
+        }
+
+        [[nodiscard]] T value() &&
+        {
+            if (!has_value())
+                error().Throw();
+            return std::move(*std::get_if<0>(&m_value));
+        }
+
+        template<typename U>
+        [[nodiscard]] T value_or(U&& defaultValue) const&
+        {
+            return has_value() ? *std::get_if<0>(&m_value) : static_cast<T>(std::forward<U>(defaultValue));
+        }
+
+        template<typename U>
+        [[nodiscard]] T value_or(U&& defaultValue) &&
+        {
+            return has_value() ? std::move(*std::get_if<0>(&m_value)) : static_cast<T>(std::forward<U>(defaultValue));
+        }
+
+        // Only valid if has_value()
+        [[nodiscard]] T& operator*() & noexcept { return *std::get_if<0>(&m_value); }
+        [[nodiscard]] const T& operator*() const& noexcept { return *std::get_if<0>(&m_value); }
+        [[nodiscard]] T* operator->() noexcept { return std::get_if<0>(&m_value); }
+        [[nodiscard]] const T* operator->() const noexcept { return std::get_if<0>(&m_value); }
+
+        // Only valid if !has_value()
+        [[nodiscard]] const ErrorInfo& error() const noexcept { return *std::get_if<1>(&m_value); }
+
+    private:
+        std::variant<T, ErrorInfo> m_value;
+    };
+
+    namespace detail
+    {
+        // Converts an Error thrown by fn into a Result, for the parts of the try_ functions that
+        // are built on throwing code (argument conversions, Object constructors)
+        template<typename T, typename Fn>
+        Result<T> CatchErrors(Fn&& fn)
+        {
+            try
+            {
+                return fn();
+            }
+            catch (const Error& e)
+            {
+                return ErrorInfo(e, std::current_exception());
+            }
+        }
+    }
+}
+
+#endif // PYCPP_RESULT_H
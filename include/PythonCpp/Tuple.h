@@ -7,6 +7,8 @@
 #include "TypeTraits.h"
 #include "Object.h"
 #include "Error.h"
+#include "BulkConversion.h"
+#include "Iterator.h"
 
 
 namespace pycpp
@@ -16,12 +18,6 @@ namespace pycpp
 
     namespace detail
     {
-        template<typename tuple_t, size_t... idx>
-        constexpr auto PyTupleUnpack(tuple_t tuple, std::index_sequence<idx...>)
-        {
-            return PyTuple_Pack(std::tuple_size<tuple_t>::value, ToObject(std::get<idx>(tuple)).get()...);
-        }
-
         // Helper for deducing slice types:
         template<size_t... idx>
         struct Seq
@@ -97,19 +93,18 @@ namespace pycpp
             , "Tuple<Ts...>: Not all types of Ts... are valid PythonBaseType");
 
     public:
+        // Iteration yields the untyped items, use at<idx>() for typed access
+        using const_iterator = detail::SequenceIterator<Object, PyTuple_GetItem>;
+        using iterator = const_iterator;
+
+        // Items are converted straight into the new tuple, see detail::BuildTuple
         Tuple(const Ts&... vals)
-        {
-            m_pObject = PyTuple_Pack(sizeof...(vals), ToObject(vals).get()...);
-            if (!m_pObject)
-                throw Error();
-        }
+            : Object(detail::BuildTuple(vals...))
+        {}
 
         Tuple(const std::tuple<Ts...>& tuple)
-        {
-            m_pObject = detail::PyTupleUnpack(tuple, std::make_index_sequence<sizeof...(Ts)>());
-            if (!m_pObject)
-                throw Error();
-        }
+            : Object(std::apply([](const auto&... vals) { return detail::BuildTuple(vals...); }, tuple))
+        {}
 
         Tuple(PyObject* pTupleObj)
             :Object(pTupleObj)
@@ -162,12 +157,22 @@ namespace pycpp
             return sizeof...(Ts);
         }
 
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+            return const_iterator(m_pObject, 0);
+        }
+
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+            return const_iterator(m_pObject, static_cast<Py_ssize_t>(sizeof...(Ts)));
+        }
+
         template<size_t idx>
         typename std::tuple_element_t<idx, std::tuple<Ts...>> at() const
         {
             auto pItem = PyTuple_GetItem(m_pObject, idx);
             if (!pItem)
-                throw Error();
+                Error::ThrowCurrent();
             return python_cast<typename std::tuple_element_t<idx, std::tuple<Ts...>>>(pItem);
         }
 
@@ -176,7 +181,7 @@ namespace pycpp
         {
             auto pSlice = PyTuple_GetSlice(m_pObject, lowIdx, highIdx);
             if (!pSlice)
-                throw Error();
+                Error::ThrowCurrent();
             return detail::TupleSlice<std::tuple<Ts...>, lowIdx, highIdx>::type(pSlice);
         }
 
@@ -6,13 +6,45 @@
 #include <type_traits>
 #include <complex>
 #include "Object.h"
+#include "Result.h"
+#include <string>
+#include <string_view>
 
 namespace pycpp
 {
+    // Structs described with PYCPP_RECORD, see Record.h
     template<typename T>
+    struct RecordTraits
+    {};
+
+    template<typename T, typename = void>
+    struct isRecord : std::false_type
+    {};
+
+    template<typename T>
+    struct isRecord<T, std::void_t<decltype(RecordTraits<T>::fields)>> : std::true_type
+    {};
+
+    template<typename T>
+    constexpr auto isRecord_v = isRecord<T>::value;
+
+    namespace detail
+    {
+        template<typename T>
+        Object RecordToObject(const T& record);
+
+        template<typename T>
+        Result<T> TryRecordFromObject(PyObject* pPyObj);
+    }
+
+    template<typename T, typename = void>
     struct isPythonBaseType : std::false_type
     {};
 
+    template<typename T>
+    struct isPythonBaseType<T, std::enable_if_t<isRecord_v<T>>> : std::true_type
+    {};
+
 #ifndef Py_LIMITED_API
     template<>
     struct isPythonBaseType<int> : std::true_type
@@ -57,6 +89,12 @@ namespace pycpp
     struct isPythonBaseType<std::string> : std::true_type
     {};
 
+    // std::string_view is not a PythonBaseType: it views the UTF-8 data of a str object and is only
+    // valid while that object is alive, so it can only be cast from a held Object (python_cast).
+    // Containers and bulk conversions, which cast temporary items, reject it
+    template<typename T>
+    constexpr bool isStringView_v = std::is_same_v<std::remove_cv_t<T>, std::string_view>;
+
     // using generic Objects should also be allowed but can be dangerous
     template<>
     struct isPythonBaseType<Object> : std::true_type
@@ -76,15 +114,41 @@ namespace pycpp
     struct isPythonBaseType<Tuple<Ts...>> : std::conjunction<isPythonBaseType<Ts>...>
     {};
 
+    class Bytes;
+
+    template<>
+    struct isPythonBaseType<Bytes> : std::true_type
+    {};
+
+    template<typename K, typename V>
+    class Dict;
+
+    template<typename K, typename V>
+    struct isPythonBaseType<Dict<K, V>> : std::conjunction<isPythonBaseType<K>, isPythonBaseType<V>>
+    {};
+
     template<typename T>
     constexpr auto isPythonBaseType_v = isPythonBaseType<T>::value;
 
+    // BufferViews are not Objects but still can be python_cast to, see Buffer.h
+    template<typename T>
+    struct isBufferView : std::false_type
+    {};
+
+    template<typename T>
+    constexpr auto isBufferView_v = isBufferView<T>::value;
+
     // base template, this will not do anything except warning about wrong types
     template<typename T, std::enable_if_t<!std::is_base_of_v<Object, T>, int> = 0>
-    [[nodiscard]] Object ToObject(const T&)
+    [[nodiscard]] inline Object ToObject(const T& val)
     {
-        static_assert(isPythonBaseType_v<T>, "ToObject: Type not supported");
-        throw Error("How did we even get here?");
+        if constexpr (isRecord_v<T>)
+            return detail::RecordToObject(val);
+        else
+        {
+            static_assert(isPythonBaseType_v<T>, "ToObject: Type not supported");
+            throw Error("How did we even get here?");
+        }
     }
 
     // note: no implementations for PyLong_FromDouble... and other implicit conversions. If you want your Object
@@ -92,95 +156,102 @@ namespace pycpp
 
 #ifndef Py_LIMITED_API
     template<>
-    [[nodiscard]] Object ToObject(const int& val)
+    [[nodiscard]] inline Object ToObject(const int& val)
     {
         Object pObject = PyLong_FromLong(val);
         if (!pObject)
-            throw Error();
+            Error::ThrowCurrent();
         return pObject;
     }
 #endif //Py_LIMITED_API
 
     template<>
-    [[nodiscard]] Object ToObject(const long& val)
+    [[nodiscard]] inline Object ToObject(const long& val)
     {
         Object pObject = PyLong_FromLong(val);
         if (!pObject)
-            throw Error(); // Maybe create badCastError or similar
+            Error::ThrowCurrent(); // Maybe create badCastError or similar
         return pObject;
     }
 
     template<>
-    [[nodiscard]] Object ToObject(const unsigned long& val)
+    [[nodiscard]] inline Object ToObject(const unsigned long& val)
     {
         Object pObject = PyLong_FromUnsignedLong(val);
         if (!pObject)
-            throw Error();
+            Error::ThrowCurrent();
         return pObject;
     }
 
     template<>
-    [[nodiscard]] Object ToObject(const long long& val)
+    [[nodiscard]] inline Object ToObject(const long long& val)
     {
         Object pObject = PyLong_FromLongLong(val);
         if (!pObject)
-            throw Error();
+            Error::ThrowCurrent();
         return pObject;
     }
 
     template<>
-    [[nodiscard]] Object ToObject(const unsigned long long& val)
+    [[nodiscard]] inline Object ToObject(const unsigned long long& val)
     {
         Object pObject = PyLong_FromUnsignedLongLong(val);
         if (!pObject)
-            throw Error();
+            Error::ThrowCurrent();
         return pObject;
     }
 
     template<>
-    [[nodiscard]] Object ToObject(const bool& val)
+    [[nodiscard]] inline Object ToObject(const bool& val)
     {
         Object pObject = PyBool_FromLong(val ? static_cast<long>(1) : static_cast<long>(0));
         if (!pObject)
-            throw Error();
+            Error::ThrowCurrent();
         return pObject;
     }
 
     template<>
-    [[nodiscard]] Object ToObject(const double& val)
+    [[nodiscard]] inline Object ToObject(const double& val)
     {
         Object pObject = PyFloat_FromDouble(val);
         if (!pObject)
-            throw Error();
+            Error::ThrowCurrent();
         return pObject;
     }
 
     template<>
-    [[nodiscard]] Object ToObject(const std::complex<double>& val)
+    [[nodiscard]] inline Object ToObject(const std::complex<double>& val)
     {
         Object pObject = PyComplex_FromDoubles(val.real(), val.imag());
         if (!pObject)
-            throw Error();
+            Error::ThrowCurrent();
         return pObject;
     }
 
-    [[nodiscard]] Object ToObject(const char* str)
+    [[nodiscard]] inline Object ToObject(const char* str)
     {
         Object pObject = PyUnicode_FromString(str);
         if (!pObject)
-            throw Error();
+            Error::ThrowCurrent();
         return pObject;
     }
 
+    // sized strings skip the strlen PyUnicode_FromString would have to do
     template<>
-    [[nodiscard]] Object ToObject(const std::string& str)
+    [[nodiscard]] inline Object ToObject(const std::string_view& str)
     {
-        Object pObject = PyUnicode_FromString(str.c_str());
+        Object pObject = PyUnicode_FromStringAndSize(str.data(), static_cast<Py_ssize_t>(str.size()));
         if (!pObject)
-            throw Error();
+            Error::ThrowCurrent();
         return pObject;
     }
 
+    template<>
+    [[nodiscard]] inline Object ToObject(const std::string& str)
+    {
+        return ToObject(std::string_view(str));
+    }
+
     template<typename T, std::enable_if_t<std::is_base_of_v<Object, T>, int> = 0>
     [[nodiscard]] constexpr T ToObject(const T& val)
     {
@@ -192,13 +263,11 @@ namespace pycpp
     // __int__() implemented (can be converted to int). This cast will also check for possible overflow
     // note: Python C API allows for conversion from int to double etc. These will not be supported.
     // Please cast them accordingly and if you need conversions cast them manually
-
-    template<typename T, std::enable_if_t<!std::is_base_of_v<Object, T>, int> = 0> // base template, this will not do anything except warning about wrong types
-    [[nodiscard]] T python_cast(const Object&)
-    {
-        static_assert(isPythonBaseType_v<T>, "python_cast: Type not supported");
-        return T{};
-    }
+    // try_python_cast does the same but returns failures in its Result instead of throwing, python_cast
+    // is built on it
+    // const char* and std::string_view point into the UTF-8 data cached by the str object, they are only
+    // valid as long as that object is alive. Casting a temporary Object to std::string_view is therefore
+    // not allowed, use std::string if the object is not held
 
     template<typename T, std::enable_if_t<std::is_base_of_v<Object, T>, int> = 0>
     [[nodiscard]] T python_cast(const Object& pyObj)
@@ -206,118 +275,6 @@ namespace pycpp
         return T{ pyObj };
     }
 
-    template<>
-    [[nodiscard]] bool python_cast<bool>(const Object& pyObj)
-    {
-        const auto check = PyObject_IsTrue(pyObj.get());
-        if (check == -1)
-            throw Error();
-        if (check == 1)
-            return true;
-        return false;
-    }
-
-#ifndef Py_LIMITED_API
-    template<>
-    [[nodiscard]] int python_cast<int>(const Object& pyObj)
-    {
-        const auto ret = _PyLong_AsInt(pyObj.get());
-        if (PyErr_Occurred())
-            throw Error();
-
-        return ret;
-    }
-#endif //Py_LIMITED_API
-
-    template<>
-    [[nodiscard]] long python_cast<long>(const Object& pyObj)
-    {
-        const auto ret = PyLong_AsLong(pyObj.get());
-        if (PyErr_Occurred())
-            throw Error();
-
-        return ret;
-    }
-
-    template<>
-    [[nodiscard]] unsigned long python_cast<unsigned long>(const Object& pyObj)
-    {
-        const auto ret = PyLong_AsUnsignedLong(pyObj.get());
-        if (PyErr_Occurred())
-            throw Error();
-
-        return ret;
-    }
-
-    template<>
-    [[nodiscard]] long long python_cast<long long>(const Object& pyObj)
-    {
-        const auto ret = PyLong_AsLongLong(pyObj.get());
-        if (PyErr_Occurred())
-            throw Error();
-
-        return ret;
-    }
-
-    template<>
-    [[nodiscard]] unsigned long long python_cast<unsigned long long>(const Object& pyObj)
-    {
-        const auto ret = PyLong_AsUnsignedLongLong(pyObj.get());
-        if (PyErr_Occurred())
-            throw Error();
-
-        return ret;
-    }
-
-    template<>
-    [[nodiscard]] double python_cast<double>(const Object& pyObj)
-    {
-        const auto ret = PyFloat_AsDouble(pyObj.get());
-        if (PyErr_Occurred())
-            throw Error();
-
-        return ret;
-    }
-
-    template<>
-    [[nodiscard]] std::complex<double> python_cast<std::complex<double>>(const Object& pyObj)
-    {
-        const auto real = PyComplex_RealAsDouble(pyObj.get());
-        if (PyErr_Occurred())
-            throw Error();
-        const auto imag = PyComplex_ImagAsDouble(pyObj.get());
-        if (PyErr_Occurred())
-            throw Error();
-
-        return { real, imag };
-    }
-
-    template<>
-    [[nodiscard]] const char* python_cast<const char*>(const Object& pyObj)
-    {
-        auto pData = PyUnicode_AsUTF8(pyObj.get());
-        if (!pData)
-            throw Error();
-        return pData;
-    }
-
-    template<>
-    [[nodiscard]] std::string python_cast<std::string>(const Object& pyObj)
-    {
-        auto pData = PyUnicode_AsUTF8(pyObj.get());
-        if (!pData)
-            throw Error();
-        return std::string(pData);
-    }
-
-    // base template, this will not do anything except warning about wrong types
-    template<typename T, std::enable_if_t<!std::is_base_of_v<Object, T>, int> = 0>
-    [[nodiscard]] T python_cast(PyObject*)
-    {
-        static_assert(isPythonBaseType_v<T>, "python_cast: Type not supported");
-        return T{};
-    }
-
     template<typename T, std::enable_if_t<std::is_base_of_v<Object, T>, int> = 0>
     [[nodiscard]] T python_cast(PyObject* pPyObj)
     {
@@ -325,110 +282,152 @@ namespace pycpp
         return T(pPyObj);
     }
 
+    // base template for records and Objects, whose constructors check the type by throwing
+    template<typename T>
+    [[nodiscard]] Result<T> try_python_cast(PyObject* pPyObj)
+    {
+        if constexpr (isRecord_v<T>)
+            return detail::TryRecordFromObject<T>(pPyObj);
+        else
+        {
+            static_assert(std::is_base_of_v<Object, T>, "try_python_cast: Type not supported");
+            return detail::CatchErrors<T>([pPyObj] { return python_cast<T>(pPyObj); });
+        }
+    }
+
     template<>
-    [[nodiscard]] bool python_cast<bool>(PyObject* pPyObj)
+    [[nodiscard]] inline Result<bool> try_python_cast<bool>(PyObject* pPyObj)
     {
         const auto check = PyObject_IsTrue(pPyObj);
         if (check == -1)
-            throw Error();
-        if (check == 1)
-            return true;
-        return false;
+            return ErrorInfo::Fetch();
+        return check == 1;
     }
 
 #ifndef Py_LIMITED_API
     template<>
-    [[nodiscard]] int python_cast<int>(PyObject* pPyObj)
+    [[nodiscard]] inline Result<int> try_python_cast<int>(PyObject* pPyObj)
     {
         const auto ret = _PyLong_AsInt(pPyObj);
-        if (PyErr_Occurred())
-            throw Error();
-
+        if (ret == -1 && PyErr_Occurred())
+            return ErrorInfo::Fetch();
         return ret;
     }
 #endif //Py_LIMITED_API
 
     template<>
-    [[nodiscard]] long python_cast<long>(PyObject* pPyObj)
+    [[nodiscard]] inline Result<long> try_python_cast<long>(PyObject* pPyObj)
     {
         const auto ret = PyLong_AsLong(pPyObj);
-        if (PyErr_Occurred())
-            throw Error();
-
+        if (ret == -1 && PyErr_Occurred())
+            return ErrorInfo::Fetch();
         return ret;
     }
 
     template<>
-    [[nodiscard]] unsigned long python_cast<unsigned long>(PyObject* pPyObj)
+    [[nodiscard]] inline Result<unsigned long> try_python_cast<unsigned long>(PyObject* pPyObj)
     {
         const auto ret = PyLong_AsUnsignedLong(pPyObj);
-        if (PyErr_Occurred())
-            throw Error();
-
+        if (ret == static_cast<unsigned long>(-1) && PyErr_Occurred())
+            return ErrorInfo::Fetch();
         return ret;
     }
 
     template<>
-    [[nodiscard]] long long python_cast<long long>(PyObject* pPyObj)
+    [[nodiscard]] inline Result<long long> try_python_cast<long long>(PyObject* pPyObj)
     {
         const auto ret = PyLong_AsLongLong(pPyObj);
-        if (PyErr_Occurred())
-            throw Error();
-
+        if (ret == -1 && PyErr_Occurred())
+            return ErrorInfo::Fetch();
         return ret;
     }
 
     template<>
-    [[nodiscard]] unsigned long long python_cast<unsigned long long>(PyObject* pPyObj)
+    [[nodiscard]] inline Result<unsigned long long> try_python_cast<unsigned long long>(PyObject* pPyObj)
     {
         const auto ret = PyLong_AsUnsignedLongLong(pPyObj);
-        if (PyErr_Occurred())
-            throw Error();
-
+        if (ret == static_cast<unsigned long long>(-1) && PyErr_Occurred())
+            return ErrorInfo::Fetch();
         return ret;
     }
 
     template<>
-    [[nodiscard]] double python_cast<double>(PyObject* pPyObj)
+    [[nodiscard]] inline Result<double> try_python_cast<double>(PyObject* pPyObj)
     {
         const auto ret = PyFloat_AsDouble(pPyObj);
-        if (PyErr_Occurred())
-            throw Error();
-
+        if (ret == -1.0 && PyErr_Occurred())
+            return ErrorInfo::Fetch();
         return ret;
     }
 
     template<>
-    [[nodiscard]] std::complex<double> python_cast<std::complex<double>>(PyObject* pPyObj)
+    [[nodiscard]] inline Result<std::complex<double>> try_python_cast<std::complex<double>>(PyObject* pPyObj)
     {
         const auto real = PyComplex_RealAsDouble(pPyObj);
-        if (!real)
-            throw Error();
+        if (real == -1.0 && PyErr_Occurred())
+            return ErrorInfo::Fetch();
         const auto imag = PyComplex_ImagAsDouble(pPyObj);
-        if (!imag)
-            throw Error();
-
-        return { real, imag };
+        if (imag == -1.0 && PyErr_Occurred())
+            return ErrorInfo::Fetch();
+        return std::complex<double>{ real, imag };
     }
 
     template<>
-    [[nodiscard]] const char* python_cast<const char*>(PyObject* pPyObj)
+    [[nodiscard]] inline Result<const char*> try_python_cast<const char*>(PyObject* pPyObj)
     {
         const auto pData = PyUnicode_AsUTF8(pPyObj);
         if (!pData)
-            throw Error();
+            return ErrorInfo::Fetch();
         return pData;
     }
 
     template<>
-    [[nodiscard]] std::string python_cast<std::string>(PyObject* pPyObj)
+    [[nodiscard]] inline Result<std::string> try_python_cast<std::string>(PyObject* pPyObj)
     {
-        auto pData = PyUnicode_AsUTF8(pPyObj);
+        Py_ssize_t size = 0;
+        const auto pData = PyUnicode_AsUTF8AndSize(pPyObj, &size);
         if (!pData)
-            throw Error();
-        return std::string(pData);
+            return ErrorInfo::Fetch();
+        return std::string(pData, static_cast<size_t>(size));
     }
 
+    template<>
+    [[nodiscard]] inline Result<std::string_view> try_python_cast<std::string_view>(PyObject* pPyObj)
+    {
+        Py_ssize_t size = 0;
+        const auto pData = PyUnicode_AsUTF8AndSize(pPyObj, &size);
+        if (!pData)
+            return ErrorInfo::Fetch();
+        return std::string_view(pData, static_cast<size_t>(size));
+    }
+
+    template<typename T>
+    [[nodiscard]] Result<T> try_python_cast(const Object& pyObj)
+    {
+        return try_python_cast<T>(pyObj.get());
+    }
+
+    template<typename T, std::enable_if_t<std::is_same_v<T, std::string_view>, int> = 0>
+    Result<T> try_python_cast(Object&& pyObj) = delete;
+
+    // base template, this will not do anything except warning about wrong types
+    template<typename T, std::enable_if_t<!std::is_base_of_v<Object, T> && !isBufferView_v<T>, int> = 0>
+    [[nodiscard]] T python_cast(PyObject* pPyObj)
+    {
+        static_assert(isPythonBaseType_v<T> || isStringView_v<T>, "python_cast: Type not supported");
+        return try_python_cast<T>(pPyObj).value();
+    }
+
+    template<typename T, std::enable_if_t<!std::is_base_of_v<Object, T> && !isBufferView_v<T>, int> = 0>
+    [[nodiscard]] T python_cast(const Object& pyObj)
+    {
+        static_assert(isPythonBaseType_v<T> || isStringView_v<T>, "python_cast: Type not supported");
+        return try_python_cast<T>(pyObj.get()).value();
+    }
+
+    template<typename T, std::enable_if_t<std::is_same_v<T, std::string_view>, int> = 0>
+    T python_cast(Object&& pyObj) = delete;
+
    /* template<typename T, std::enable_if_t<isPythonBaseType_v<T>, int> = 0>
     [[nodiscard]] List<T> python_cast<List<T>>(PyObject* pPyObj)
     {
@@ -8,17 +8,26 @@
 
 #include "Object.h"
 #include "Error.h"
+#include "Result.h"
+#include "AttributeName.h"
 #include <string>
 
 namespace pycpp
 {
+    // Imports on every call, see ModuleCache (Module.h) for modules used on hot paths
     PYCPP_API Object ImportModule(const char* module_name);
     PYCPP_API Object ImportModule(const std::string& module_name);
 
+    // Same as ImportModule, but failures are returned instead of thrown, see Result.h
+    [[nodiscard]] PYCPP_API Result<Object> TryImportModule(const char* module_name);
+    [[nodiscard]] PYCPP_API Result<Object> TryImportModule(const std::string& module_name);
+
     PYCPP_API Object GetAttributeString(PyObject* pObject, const char* attr_name);
     PYCPP_API Object GetAttributeString(const Object& pObject, const char* attr_name);
     PYCPP_API Object GetAttributeString(PyObject* pObject, const std::string& attr_name);
     PYCPP_API Object GetAttributeString(const Object& pObject, const std::string& attr_name);
+    PYCPP_API Object GetAttributeString(PyObject* pObject, const AttributeName& attr_name);
+    PYCPP_API Object GetAttributeString(const Object& pObject, const AttributeName& attr_name);
 }
 
 #endif // PYTHON_UTILITIES_H
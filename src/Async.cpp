@@ -0,0 +1,181 @@
+#include "Async.h"
+#include "Utilities.h"
+#include "AttributeName.h"
+#include "Module.h"
+
+namespace
+{
+    // Python side of the bridge, defined once per interpreter
+    constexpr const char* s_helperSource = R"(
+import asyncio
+
+async def await_(awaitable):
+    return await awaitable
+
+def shutdown(loop):
+    tasks = asyncio.all_tasks(loop)
+    for task in tasks:
+        task.cancel()
+    loop.run_until_complete(asyncio.gather(*tasks, return_exceptions=True))
+    loop.run_until_complete(loop.shutdown_asyncgens())
+    loop.close()
+)";
+
+    const pycpp::LazyModule s_asyncio("asyncio");
+
+    pycpp::Object Helper(const pycpp::AttributeName& name)
+    {
+        static pycpp::detail::InterpreterLocalRef s_helpers;
+        auto* pHelpers = s_helpers.Get([]()
+            {
+                pycpp::Object globals = PyDict_New();
+                if (!globals || PyDict_SetItemString(globals.get(), "__builtins__", PyEval_GetBuiltins()) < 0)
+                    pycpp::Error::ThrowCurrent();
+                pycpp::Object result = PyRun_String(s_helperSource, Py_file_input, globals.get(), globals.get());
+                if (!result)
+                    pycpp::Error::ThrowCurrent();
+                return globals;
+            });
+        auto* pHelper = PyDict_GetItemWithError(pHelpers, name.Get());
+        if (!pHelper)
+            pycpp::Error::ThrowCurrent();
+        return pycpp::Object::BorrowedRef(pHelper);
+    }
+
+    // done callback of the concurrent.futures.Future returned by run_coroutine_threadsafe, self is a capsule of the state
+    PyObject* OnAwaitableDone(PyObject* pCapsule, PyObject* pFuture)
+    {
+        auto* pState = static_cast<pycpp::detail::AsyncState*>(PyCapsule_GetPointer(pCapsule, nullptr));
+        if (!pState)
+            return nullptr;
+
+        try
+        {
+            pycpp::Object result = PyObject_CallMethodNoArgs(pFuture, PYCPP_NAME("result").Get());
+            if (!result)
+                pycpp::Error::ThrowCurrent();
+            pState->SetResult(result);
+        }
+        catch (...)
+        {
+            pState->exception = std::current_exception();
+        }
+
+        // if await_suspend did not return yet, it does not suspend and the coroutine just continues
+        if (pState->done.exchange(true, std::memory_order_acq_rel))
+        {
+            pycpp::GILRelease release;
+            pState->handle.resume();
+        }
+        Py_RETURN_NONE;
+    }
+
+    PyMethodDef s_onDoneDef{ "pycpp_awaitable_done", OnAwaitableDone, METH_O, nullptr };
+}
+
+bool pycpp::detail::ScheduleAwaitable(PyObject* pLoop, PyObject* pAwaitable, AsyncState* pState) noexcept
+{
+    GILAcquire gil;
+    try
+    {
+        Object awaitable(pAwaitable);
+        Object coroutine = Callable(Helper(PYCPP_NAME("await_")))(awaitable);
+        Object future = Callable(s_asyncio.GetAttribute(PYCPP_NAME("run_coroutine_threadsafe")))(coroutine, Object::BorrowedRef(pLoop));
+
+        Object capsule = PyCapsule_New(pState, nullptr, nullptr);
+        if (!capsule)
+            Error::ThrowCurrent();
+        Object onDone = PyCFunction_New(&s_onDoneDef, capsule.get());
+        if (!onDone)
+            Error::ThrowCurrent();
+        detail::InvokeMethod(PYCPP_NAME("add_done_callback").Get(), future, onDone);
+    }
+    catch (...)
+    {
+        pState->exception = std::current_exception();
+        return false;
+    }
+    // the callback may already have run on the loop thread, then there is nothing to wait for
+    return !pState->done.exchange(true, std::memory_order_acq_rel);
+}
+
+void pycpp::detail::ReleaseWithGIL(PyObject* pObject) noexcept
+{
+    GILAcquire gil;
+    Py_XDECREF(pObject);
+}
+
+pycpp::EventLoop::EventLoop()
+    : m_handle(Interpreter::Handle())
+{
+    std::promise<void> started;
+    auto startedFuture = started.get_future();
+    m_thread = std::thread([this, &started] { Run(started); });
+
+    // the loop thread needs the GIL to start up
+    if (detail::HoldsGIL())
+    {
+        GILRelease release;
+        startedFuture.wait();
+    }
+    else
+        startedFuture.wait();
+
+    try
+    {
+        startedFuture.get();
+    }
+    catch (...)
+    {
+        m_thread.join();
+        throw;
+    }
+}
+
+pycpp::EventLoop::~EventLoop()
+{
+    {
+        GILAcquire gil;
+        Object stop = m_loop.GetAttribute(PYCPP_NAME("stop"));
+        detail::InvokeMethod(PYCPP_NAME("call_soon_threadsafe").Get(), m_loop, stop);
+    }
+
+    if (detail::HoldsGIL())
+    {
+        GILRelease release;
+        m_thread.join();
+    }
+    else
+        m_thread.join();
+}
+
+void pycpp::EventLoop::Run(std::promise<void>& started) noexcept
+{
+    GILAcquire gil;
+    try
+    {
+        m_loop = Callable(s_asyncio.GetAttribute(PYCPP_NAME("new_event_loop")))();
+        Callable(s_asyncio.GetAttribute(PYCPP_NAME("set_event_loop")))(m_loop);
+        Helper(PYCPP_NAME("shutdown"));
+    }
+    catch (...)
+    {
+        m_loop = nullptr;
+        started.set_exception(std::current_exception());
+        return;
+    }
+    started.set_value();
+
+    try
+    {
+        // releases the GIL while waiting for I/O
+        detail::InvokeMethod(PYCPP_NAME("run_forever").Get(), m_loop);
+        Callable(Helper(PYCPP_NAME("shutdown")))(m_loop);
+    }
+    catch (...)
+    {
+        // the loop failed, there is no one to report it to
+        PyErr_Clear();
+    }
+    m_loop = nullptr;
+}
@@ -0,0 +1,54 @@
+#include "AttributeName.h"
+#include "Error.h"
+
+PyObject* pycpp::detail::InternName(std::string_view name)
+{
+    auto& names = CurrentInterpreterState().internedNames;
+    const auto it = names.find(name);
+    if (it != names.end())
+        return it->second.get();
+
+    PyObject* pName = PyUnicode_FromStringAndSize(name.data(), static_cast<Py_ssize_t>(name.size()));
+    if (!pName)
+        Error::ThrowCurrent();
+    PyUnicode_InternInPlace(&pName);
+    Object pyName(pName);
+
+    Py_ssize_t size = 0;
+    const char* pData = PyUnicode_AsUTF8AndSize(pName, &size);
+    if (!pData)
+        Error::ThrowCurrent();
+
+    names.emplace(std::string_view(pData, static_cast<size_t>(size)), std::move(pyName));
+    return pName;
+}
+
+pycpp::Object pycpp::detail::NameObject(std::string_view name) noexcept
+{
+    auto& names = CurrentInterpreterState().internedNames;
+    const auto it = names.find(name);
+    if (it != names.end())
+        return it->second;
+    return PyUnicode_FromStringAndSize(name.data(), static_cast<Py_ssize_t>(name.size()));
+}
+
+PyObject* pycpp::detail::TryInternName(std::string_view name) noexcept
+{
+    try
+    {
+        return InternName(name);
+    }
+    catch (...)
+    {
+        PyErr_Clear();
+        return nullptr;
+    }
+}
+
+PyObject* pycpp::AttributeName::Get() const
+{
+    return m_pyName.Get([this]()
+        {
+            return Object::BorrowedRef(detail::InternName(m_name));
+        });
+}
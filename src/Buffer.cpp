@@ -0,0 +1,226 @@
+#include "Buffer.h"
+#include "Interpreter.h"
+#include <numeric>
+
+namespace
+{
+    struct BufferExporterObject
+    {
+        PyObject_HEAD
+        pycpp::detail::BufferInfo* pInfo;
+    };
+
+    bool IsCContiguous(const pycpp::detail::BufferInfo& info) noexcept
+    {
+        auto expected = info.itemSize;
+        for (auto idx = info.shape.size(); idx > 0; --idx)
+        {
+            if (info.shape[idx - 1] > 1 && info.strides[idx - 1] != expected)
+                return false;
+            expected *= info.shape[idx - 1];
+        }
+        return true;
+    }
+
+    bool IsFContiguous(const pycpp::detail::BufferInfo& info) noexcept
+    {
+        auto expected = info.itemSize;
+        for (size_t idx = 0; idx < info.shape.size(); ++idx)
+        {
+            if (info.shape[idx] > 1 && info.strides[idx] != expected)
+                return false;
+            expected *= info.shape[idx];
+        }
+        return true;
+    }
+
+    int BufferExporterGetBuffer(PyObject* pExporter, Py_buffer* pView, int flags)
+    {
+        const auto& info = *reinterpret_cast<BufferExporterObject*>(pExporter)->pInfo;
+
+        if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE && info.readOnly)
+        {
+            PyErr_SetString(PyExc_BufferError, "Buffer is read-only");
+            return -1;
+        }
+        // the contiguity requests include PyBUF_STRIDES, so they are checked first
+        if ((flags & PyBUF_ANY_CONTIGUOUS) == PyBUF_ANY_CONTIGUOUS)
+        {
+            if (!IsCContiguous(info) && !IsFContiguous(info))
+            {
+                PyErr_SetString(PyExc_BufferError, "Buffer is not contiguous");
+                return -1;
+            }
+        }
+        else if ((flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS || (flags & PyBUF_STRIDES) != PyBUF_STRIDES)
+        {
+            if (!IsCContiguous(info))
+            {
+                PyErr_SetString(PyExc_BufferError, "Buffer is not C-contiguous");
+                return -1;
+            }
+        }
+        else if ((flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS && !IsFContiguous(info))
+        {
+            PyErr_SetString(PyExc_BufferError, "Buffer is not Fortran-contiguous");
+            return -1;
+        }
+
+        pView->obj = pExporter;
+        Py_INCREF(pExporter);
+        pView->buf = const_cast<void*>(info.pData);
+        pView->itemsize = info.itemSize;
+        pView->len = std::accumulate(info.shape.begin(), info.shape.end(), info.itemSize, std::multiplies<Py_ssize_t>());
+        pView->readonly = info.readOnly ? 1 : 0;
+        pView->ndim = static_cast<int>(info.shape.size());
+        pView->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? const_cast<char*>(info.format) : nullptr;
+        pView->shape = (flags & PyBUF_ND) == PyBUF_ND ? const_cast<Py_ssize_t*>(info.shape.data()) : nullptr;
+        pView->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? const_cast<Py_ssize_t*>(info.strides.data()) : nullptr;
+        pView->suboffsets = nullptr;
+        pView->internal = nullptr;
+        return 0;
+    }
+
+    void BufferExporterDealloc(PyObject* pExporter)
+    {
+        auto* pType = Py_TYPE(pExporter);
+        delete reinterpret_cast<BufferExporterObject*>(pExporter)->pInfo;
+        pType->tp_free(pExporter);
+        Py_DECREF(pType);
+    }
+
+    // Exporters are only created by MakeBufferExporter, one created from Python would have no memory to export
+    PyObject* BufferExporterNew(PyTypeObject* pType, PyObject*, PyObject*)
+    {
+        PyErr_Format(PyExc_TypeError, "cannot create '%s' instances", pType->tp_name);
+        return nullptr;
+    }
+
+    PyObject* BufferExporterType()
+    {
+        static pycpp::detail::InterpreterLocalRef s_type;
+        return s_type.Get([]()
+            {
+                static PyType_Slot slots[] = {
+                    { Py_tp_dealloc, reinterpret_cast<void*>(&BufferExporterDealloc) },
+                    { Py_tp_new, reinterpret_cast<void*>(&BufferExporterNew) },
+                    { Py_bf_getbuffer, reinterpret_cast<void*>(&BufferExporterGetBuffer) },
+                    { Py_tp_doc, const_cast<char*>("Exports C++ memory through the buffer protocol") },
+                    { 0, nullptr }
+                };
+                static PyType_Spec spec = {
+                    "pycpp.BufferExporter",
+                    sizeof(BufferExporterObject),
+                    0,
+                    Py_TPFLAGS_DEFAULT,
+                    slots
+                };
+                pycpp::Object type = PyType_FromSpec(&spec);
+                if (!type)
+                    pycpp::Error::ThrowCurrent();
+                return type;
+            });
+    }
+}
+
+pycpp::Object pycpp::detail::MakeBufferExporter(BufferInfo info)
+{
+    if (info.shape.empty())
+        throw Error("Buffer needs at least one dimension");
+    for (const auto extent : info.shape)
+    {
+        if (extent < 0)
+            throw Error("Buffer extents must not be negative");
+    }
+    if (info.strides.empty())
+    {
+        // row-major
+        info.strides.resize(info.shape.size());
+        auto stride = info.itemSize;
+        for (auto idx = info.shape.size(); idx > 0; --idx)
+        {
+            info.strides[idx - 1] = stride;
+            stride *= info.shape[idx - 1];
+        }
+    }
+    else if (info.strides.size() != info.shape.size())
+        throw Error("Buffer strides and shape differ in dimension");
+
+    auto* pType = reinterpret_cast<PyTypeObject*>(BufferExporterType());
+    Object exporter = pType->tp_alloc(pType, 0);
+    if (!exporter)
+        Error::ThrowCurrent();
+    reinterpret_cast<BufferExporterObject*>(exporter.get())->pInfo = new BufferInfo(std::move(info));
+    return exporter;
+}
+
+void pycpp::detail::CheckBufferFormat(const Py_buffer& view, BufferKind kind, size_t itemSize)
+{
+    // a missing format means unsigned bytes
+    const char* format = view.format ? view.format : "B";
+    const char* code = format;
+
+    // only native byte order can be viewed as T
+    constexpr bool littleEndian = PY_LITTLE_ENDIAN != 0;
+    if (*code == '@' || *code == '=' || (*code == '<' && littleEndian) || (*code == '>' && !littleEndian) || (*code == '!' && !littleEndian))
+        ++code;
+
+    bool matches = false;
+    if (code[0] == 'Z')
+        matches = kind == BufferKind::Complex && (code[1] == 'f' || code[1] == 'd') && code[2] == '\0';
+    else if (code[0] != '\0' && code[1] == '\0')
+    {
+        switch (code[0])
+        {
+        case '?':
+            matches = kind == BufferKind::Bool;
+            break;
+        case 'c':
+            matches = kind == BufferKind::Char;
+            break;
+        case 'b': case 'h': case 'i': case 'l': case 'q': case 'n':
+            matches = kind == BufferKind::Signed || (kind == BufferKind::Char && code[0] == 'b');
+            break;
+        case 'B': case 'H': case 'I': case 'L': case 'Q': case 'N':
+            matches = kind == BufferKind::Unsigned || (kind == BufferKind::Char && code[0] == 'B');
+            break;
+        case 'e': case 'f': case 'd':
+            matches = kind == BufferKind::Float;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (!matches || static_cast<size_t>(view.itemsize) != itemSize)
+        throw Error("Buffer format '" + std::string(format) + "' with item size " + std::to_string(view.itemsize)
+            + " does not match the requested type of size " + std::to_string(itemSize));
+}
+
+pycpp::Buffer::Buffer(const Buffer& other)
+    :Object(other)
+{}
+
+pycpp::Buffer& pycpp::Buffer::operator=(const Buffer& other)
+{
+    Object::operator=(other);
+    return *this;
+}
+
+pycpp::Buffer::Buffer(Buffer&& other) noexcept
+    :Object(std::move(other))
+{}
+
+pycpp::Buffer& pycpp::Buffer::operator=(Buffer&& other) noexcept
+{
+    Object::operator=(std::move(other));
+    return *this;
+}
+
+pycpp::Object pycpp::Buffer::MemoryView() const
+{
+    Object memoryView = PyMemoryView_FromObject(m_pObject);
+    if (!memoryView)
+        Error::ThrowCurrent();
+    return memoryView;
+}
@@ -0,0 +1,91 @@
+#include "Bytes.h"
+
+pycpp::Bytes::Bytes()
+    : Bytes(std::string_view())
+{}
+
+pycpp::Bytes::Bytes(std::span<const std::byte> data)
+    : Bytes(std::string_view(reinterpret_cast<const char*>(data.data()), data.size()))
+{}
+
+pycpp::Bytes::Bytes(std::string_view data)
+    : Object(PyBytes_FromStringAndSize(data.data(), static_cast<Py_ssize_t>(data.size())))
+{
+    if (!m_pObject)
+        Error::ThrowCurrent();
+}
+
+pycpp::Bytes::Bytes(PyObject* pBytesObj)
+    : Object(pBytesObj)
+{
+    if (PyBytes_Check(pBytesObj) == 0)
+        throw Error("PyObject not of Bytes type");
+}
+
+pycpp::Bytes::Bytes(const Bytes& other)
+    : Object(other)
+{}
+
+pycpp::Bytes& pycpp::Bytes::operator=(const Bytes& other)
+{
+    Object::operator=(other);
+    return *this;
+}
+
+pycpp::Bytes::Bytes(Bytes&& other) noexcept
+    : Object(std::move(other))
+{}
+
+pycpp::Bytes& pycpp::Bytes::operator=(Bytes&& other) noexcept
+{
+    Object::operator=(std::move(other));
+    return *this;
+}
+
+pycpp::Bytes::Bytes(const Object& other)
+    : Object(other)
+{
+    if (PyBytes_Check(m_pObject) == 0)
+        throw Error("PyObject not of Bytes type");
+}
+
+pycpp::Bytes& pycpp::Bytes::operator=(const Object& other)
+{
+    if (PyBytes_Check(other.get()) == 0)
+        throw Error("PyObject not of Bytes type");
+    Object::operator=(other);
+    return *this;
+}
+
+size_t pycpp::Bytes::size() const noexcept
+{
+#ifndef Py_LIMITED_API
+    return static_cast<size_t>(PyBytes_GET_SIZE(m_pObject));
+#else
+    return static_cast<size_t>(PyBytes_Size(m_pObject));
+#endif // Py_LIMITED_API
+}
+
+const std::byte* pycpp::Bytes::data() const noexcept
+{
+    return MutableData();
+}
+
+std::span<const std::byte> pycpp::Bytes::View() const noexcept
+{
+    return std::span<const std::byte>(data(), size());
+}
+
+std::string_view pycpp::Bytes::StringView() const noexcept
+{
+    return std::string_view(reinterpret_cast<const char*>(data()), size());
+}
+
+std::byte* pycpp::Bytes::MutableData() const noexcept
+{
+#ifndef Py_LIMITED_API
+    return reinterpret_cast<std::byte*>(PyBytes_AS_STRING(m_pObject));
+#else
+    return reinterpret_cast<std::byte*>(PyBytes_AsString(m_pObject));
+#endif // Py_LIMITED_API
+}
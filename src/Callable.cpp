@@ -2,9 +2,9 @@
 
 pycpp::Object pycpp::CallObject(PyObject* pCallableObject, PyObject* pArglist)
 {
-    Object retVal = PyEval_CallObject(pCallableObject, pArglist);
+    Object retVal = PyObject_CallObject(pCallableObject, pArglist);
     if (!retVal)
-        throw Error();
+        Error::ThrowCurrent();
     return retVal;
 }
 
@@ -23,6 +23,22 @@ pycpp::Object pycpp::CallObject(const Object& callableObject, const Object& argl
     return CallObject(callableObject.get(), arglist.get());
 }
 
+pycpp::Object pycpp::VectorcallObject(PyObject* pCallableObject, PyObject* const* ppArgs, size_t nargsf, PyObject* pKwnames)
+{
+    Object retVal = PyObject_Vectorcall(pCallableObject, ppArgs, nargsf, pKwnames);
+    if (!retVal)
+        Error::ThrowCurrent();
+    return retVal;
+}
+
+pycpp::Object pycpp::VectorcallMethod(PyObject* pName, PyObject* const* ppArgs, size_t nargsf, PyObject* pKwnames)
+{
+    Object retVal = PyObject_VectorcallMethod(pName, ppArgs, nargsf, pKwnames);
+    if (!retVal)
+        Error::ThrowCurrent();
+    return retVal;
+}
+
 pycpp::Callable::Callable(PyObject* pCallableObject)
     :Object(pCallableObject)
 {
@@ -64,3 +80,20 @@ pycpp::Callable& pycpp::Callable::operator=(const Object& other)
     Object::operator=(other);
     return *this;
 }
+
+pycpp::MethodHandle::MethodHandle(std::string methodName)
+    : m_methodName(std::move(methodName))
+{}
+
+const std::string& pycpp::MethodHandle::MethodName() const noexcept
+{
+    return m_methodName;
+}
+
+PyObject* pycpp::MethodHandle::Name() const
+{
+    return m_name.Get([this]()
+        {
+            return Object::BorrowedRef(detail::InternName(m_methodName));
+        });
+}
@@ -0,0 +1,135 @@
+#include "Class.h"
+
+namespace
+{
+    PyObject* NoConstructor(PyTypeObject* pType, PyObject*, PyObject*)
+    {
+        PyErr_Format(PyExc_TypeError, "cannot create '%s' instances", pType->tp_name);
+        return nullptr;
+    }
+}
+
+pycpp::detail::ClassSpec::ClassSpec(std::string name, std::string doc, size_t basicSize, destructor dealloc)
+    : m_name(std::move(name)), m_doc(std::move(doc)), m_basicSize(static_cast<int>(basicSize)), m_dealloc(dealloc), m_constructor(&NoConstructor)
+{}
+
+void pycpp::detail::ClassSpec::AddMethod(const char* pName, FastcallMethod method, const char* pDoc)
+{
+    CheckNotInUse();
+    PyMethodDef def{};
+    def.ml_name = Store(pName);
+    // METH_FASTCALL methods take the arguments as array, the cast is the documented way to store them
+    def.ml_meth = reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(method));
+    def.ml_flags = METH_FASTCALL;
+    def.ml_doc = Store(pDoc);
+    m_methods.push_back(def);
+}
+
+void pycpp::detail::ClassSpec::AddProperty(const char* pName, getter get, setter set, const char* pDoc)
+{
+    CheckNotInUse();
+    PyGetSetDef def{};
+    def.name = Store(pName);
+    def.get = get;
+    def.set = set;
+    def.doc = Store(pDoc);
+    m_properties.push_back(def);
+}
+
+void pycpp::detail::ClassSpec::SetConstructor(newfunc constructor)
+{
+    CheckNotInUse();
+    m_constructor = constructor;
+}
+
+PyTypeObject* pycpp::detail::ClassSpec::Type() const
+{
+    // interpreters on other threads may create their type at the same time
+    std::call_once(m_frozen, [this]()
+        {
+            // the type keeps pointers to the sentinel terminated arrays
+            m_methods.push_back(PyMethodDef{});
+            m_properties.push_back(PyGetSetDef{});
+            m_inUse.store(true, std::memory_order_release);
+        });
+
+    return reinterpret_cast<PyTypeObject*>(m_type.Get([this]()
+        {
+            std::vector<PyType_Slot> slots = {
+                { Py_tp_dealloc, reinterpret_cast<void*>(m_dealloc) },
+                { Py_tp_new, reinterpret_cast<void*>(m_constructor) },
+                { Py_tp_methods, m_methods.data() },
+                { Py_tp_getset, m_properties.data() }
+            };
+            if (!m_doc.empty())
+                slots.push_back({ Py_tp_doc, const_cast<char*>(m_doc.c_str()) });
+            slots.push_back({ 0, nullptr });
+
+            PyType_Spec spec = {
+                m_name.c_str(),
+                m_basicSize,
+                0,
+                Py_TPFLAGS_DEFAULT,
+                slots.data()
+            };
+            Object type = PyType_FromSpec(&spec);
+            if (!type)
+                Error::ThrowCurrent();
+            return type;
+        }));
+}
+
+bool pycpp::detail::ClassSpec::IsInUse() const noexcept
+{
+    return m_inUse.load(std::memory_order_acquire);
+}
+
+void pycpp::detail::ClassSpec::CheckNotInUse() const
+{
+    if (IsInUse())
+        throw Error("Class: " + m_name + " is already in use and can't be changed anymore");
+}
+
+const char* pycpp::detail::ClassSpec::Store(const char* pString)
+{
+    if (!pString)
+        return nullptr;
+    return m_strings.emplace_back(pString).c_str();
+}
+
+PyObject* pycpp::detail::ArgumentCountError(PyObject* pSelf, Py_ssize_t expected, Py_ssize_t given) noexcept
+{
+    PyErr_Format(PyExc_TypeError, "%s method takes %zd positional argument%s but %zd %s given",
+        Py_TYPE(pSelf)->tp_name, expected, expected == 1 ? "" : "s", given, given == 1 ? "was" : "were");
+    return nullptr;
+}
+
+int pycpp::detail::DeleteAttributeError() noexcept
+{
+    PyErr_SetString(PyExc_TypeError, "cannot delete the property of a C++ object");
+    return -1;
+}
+
+bool pycpp::detail::CheckConstructorArguments(PyTypeObject* pType, PyObject* pArgs, PyObject* pKwargs, Py_ssize_t expected) noexcept
+{
+    if (pKwargs && PyDict_Size(pKwargs) != 0)
+    {
+        PyErr_Format(PyExc_TypeError, "%s() takes no keyword arguments", pType->tp_name);
+        return false;
+    }
+    const auto given = PyTuple_Size(pArgs);
+    if (given != expected)
+    {
+        PyErr_Format(PyExc_TypeError, "%s() takes %zd positional argument%s but %zd %s given",
+            pType->tp_name, expected, expected == 1 ? "" : "s", given, given == 1 ? "was" : "were");
+        return false;
+    }
+    return true;
+}
+
+void pycpp::detail::FreeInstance(PyObject* pInstance) noexcept
+{
+    auto* pType = Py_TYPE(pInstance);
+    pType->tp_free(pInstance);
+    Py_DECREF(pType);
+}
@@ -0,0 +1,54 @@
+#include "Columns.h"
+#ifndef Py_LIMITED_API
+#include "structmember.h"
+#endif // Py_LIMITED_API
+
+pycpp::detail::AttributeReader::AttributeReader(const char* pName)
+    : m_pName(InternName(pName))
+{}
+
+PyObject* pycpp::detail::AttributeReader::Read(PyObject* pObject)
+{
+    auto pType = Py_TYPE(pObject);
+#ifndef Py_LIMITED_API
+    if (pType != m_pType || pType->tp_version_tag != m_typeVersion)
+        Resolve(pType);
+    if (m_slotOffset >= 0)
+    {
+        if (auto pValue = *reinterpret_cast<PyObject**>(reinterpret_cast<char*>(pObject) + m_slotOffset))
+            return pValue;
+        // unset slots raise AttributeError in the regular lookup
+    }
+#else
+    (void)pType;
+#endif // Py_LIMITED_API
+    m_value = Object(PyObject_GetAttr(pObject, m_pName));
+    if (!m_value)
+        Error::ThrowCurrent();
+    return m_value.get();
+}
+
+void pycpp::detail::AttributeReader::Resolve(PyTypeObject* pType) noexcept
+{
+#ifndef Py_LIMITED_API
+    m_slotOffset = -1;
+    // borrowed, no error is set if the attribute does not exist. The lookup also assigns the type
+    // its version tag, which changes whenever the type is modified
+    PyObject* pDescriptor = _PyType_Lookup(pType, m_pName);
+    m_pType = pType;
+    m_typeVersion = pType->tp_version_tag;
+    if (m_typeVersion == 0) // changes can not be detected, so nothing is cached
+        m_pType = nullptr;
+
+    // a custom __getattribute__ or __getattr__ could return anything
+    if (!m_pType || pType->tp_getattro != PyObject_GenericGetAttr)
+        return;
+    if (!pDescriptor || !Py_IS_TYPE(pDescriptor, &PyMemberDescr_Type))
+        return;
+    const PyMemberDef* pMember = reinterpret_cast<PyMemberDescrObject*>(pDescriptor)->d_member;
+    if (pMember->type == T_OBJECT_EX)
+        m_slotOffset = pMember->offset;
+#else
+    (void)pType;
+#endif // Py_LIMITED_API
+}
@@ -0,0 +1,70 @@
+#include "Dict.h"
+
+// The known hash functions are private API and not exported anymore since Python 3.13. Without
+// them, str keys still skip rehashing because str objects cache their hash
+#if !defined(Py_LIMITED_API) && PY_VERSION_HEX < 0x030D0000
+#define PYCPP_DICT_KNOWN_HASH
+#endif
+
+pycpp::DictKey::DictKey(const char* key)
+    : DictKey(ToObject(key))
+{}
+
+pycpp::DictKey::DictKey(Object key)
+{
+    if (!key)
+        throw Error("Null Object passed as DictKey");
+    if (PyUnicode_CheckExact(key.get()))
+    {
+        PyObject* pKey = key.ReleaseOwnership();
+        PyUnicode_InternInPlace(&pKey);
+        key = Object(pKey);
+    }
+    m_hash = PyObject_Hash(key.get());
+    if (m_hash == -1)
+        Error::ThrowCurrent();
+    m_key = std::move(key);
+}
+
+pycpp::DictKey::DictKey(const AttributeName& name)
+    : DictKey(Object::BorrowedRef(name.Get()))
+{}
+
+PyObject* pycpp::detail::DictGetItem(PyObject* pDict, const DictKey& key) noexcept
+{
+#ifdef PYCPP_DICT_KNOWN_HASH
+    return _PyDict_GetItem_KnownHash(pDict, key.Get(), key.Hash());
+#else
+    return PyDict_GetItemWithError(pDict, key.Get());
+#endif
+}
+
+void pycpp::detail::DictSetItem(PyObject* pDict, const DictKey& key, PyObject* pValue)
+{
+#ifdef PYCPP_DICT_KNOWN_HASH
+    const auto ret = _PyDict_SetItem_KnownHash(pDict, key.Get(), pValue, key.Hash());
+#else
+    const auto ret = PyDict_SetItem(pDict, key.Get(), pValue);
+#endif
+    if (ret == -1)
+        Error::ThrowCurrent();
+}
+
+bool pycpp::detail::DictContains(PyObject* pDict, const DictKey& key)
+{
+#ifdef PYCPP_DICT_KNOWN_HASH
+    const auto ret = _PyDict_Contains_KnownHash(pDict, key.Get(), key.Hash());
+#else
+    const auto ret = PyDict_Contains(pDict, key.Get());
+#endif
+    if (ret == -1)
+        Error::ThrowCurrent();
+    return ret == 1;
+}
+
+void pycpp::detail::SetKeyError(PyObject* pKey) noexcept
+{
+    Object args = PyTuple_Pack(1, pKey);
+    if (args)
+        PyErr_SetObject(PyExc_KeyError, args.get());
+}
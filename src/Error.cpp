@@ -1,7 +1,87 @@
 #include "Error.h"
+#include "Interpreter.h"
+#include "Result.h"
+#include <mutex>
+
+struct pycpp::detail::ErrorState
+{
+    PyObject* pType = nullptr;
+    PyObject* pValue = nullptr;
+    PyObject* pTraceback = nullptr;
+    InterpreterKey owner;
+    std::once_flag formatted;
+    std::string message;
+
+    ~ErrorState();
+
+    // needs the GIL of the owner for all of these
+    void Normalize() noexcept
+    {
+        if (pType)
+            PyErr_NormalizeException(&pType, &pValue, &pTraceback);
+    }
+
+    void Format() noexcept
+    {
+        // formatting must not clobber an exception that is currently set
+        PyObject* pCurrentType;
+        PyObject* pCurrentValue;
+        PyObject* pCurrentTraceback;
+        PyErr_Fetch(&pCurrentType, &pCurrentValue, &pCurrentTraceback);
+        Normalize();
+        message = Object::BorrowedRef(pValue).StringRepr() + Object::BorrowedRef(pTraceback).StringRepr();
+        PyErr_Restore(pCurrentType, pCurrentValue, pCurrentTraceback);
+    }
+
+    void Release() noexcept
+    {
+        Py_CLEAR(pType);
+        Py_CLEAR(pValue);
+        Py_CLEAR(pTraceback);
+    }
+};
+
+namespace
+{
+    // Runs fn with the GIL of the interpreter identified by owner, false if that is not possible
+    // from this thread
+    template<typename Fn>
+    bool WithOwnerGIL(const pycpp::detail::InterpreterKey& owner, Fn&& fn) noexcept
+    {
+        if (pycpp::detail::IsCurrentInterpreter(owner))
+        {
+            fn();
+            return true;
+        }
+        if (!pycpp::detail::HoldsGIL() && pycpp::detail::IsMainInterpreterAlive(owner))
+        {
+            pycpp::GILAcquire gil;
+            fn();
+            return true;
+        }
+        return false;
+    }
+}
+
+pycpp::detail::ErrorState::~ErrorState()
+{
+    // if the interpreter is gone (or not reachable from here), the references are dropped
+    if (pType || pValue || pTraceback)
+        WithOwnerGIL(owner, [this] { Release(); });
+}
+
+std::shared_ptr<pycpp::detail::ErrorState> pycpp::detail::FetchErrorState()
+{
+    if (!PyErr_Occurred())
+        return nullptr;
+    auto pState = std::make_shared<ErrorState>();
+    pState->owner = CurrentInterpreterKey();
+    PyErr_Fetch(&pState->pType, &pState->pValue, &pState->pTraceback);
+    return pState;
+}
 
 pycpp::Error::Error()
-    : std::runtime_error(RetrievePyErrorString())
+    : std::runtime_error("Unknown Python error"), m_pState(detail::FetchErrorState())
 {}
 
 pycpp::Error::Error(const std::string & errMsg)
@@ -12,6 +92,98 @@ pycpp::Error::Error(const char* errMsg)
     : std::runtime_error(errMsg)
 {}
 
+const char* pycpp::Error::what() const noexcept
+{
+    if (!m_pState)
+        return std::runtime_error::what();
+
+    auto& state = *m_pState;
+    std::call_once(state.formatted, [&state]
+        {
+            if (!WithOwnerGIL(state.owner, [&state] { state.Format(); }))
+            {
+                // the type is kept alive by the state, so its name can be read without the GIL
+                const char* pTypeName = state.pType ? reinterpret_cast<PyTypeObject*>(state.pType)->tp_name : "exception";
+                state.message = std::string("Python ") + pTypeName + " raised in an interpreter not available to this thread";
+            }
+        });
+    return state.message.c_str();
+}
+
+pycpp::Object pycpp::Error::Type() const
+{
+    if (!m_pState)
+        return Object();
+    m_pState->Normalize();
+    return Object::BorrowedRef(m_pState->pType);
+}
+
+pycpp::Object pycpp::Error::Value() const
+{
+    if (!m_pState)
+        return Object();
+    m_pState->Normalize();
+    return Object::BorrowedRef(m_pState->pValue);
+}
+
+pycpp::Object pycpp::Error::Traceback() const
+{
+    if (!m_pState)
+        return Object();
+    m_pState->Normalize();
+    return Object::BorrowedRef(m_pState->pTraceback);
+}
+
+bool pycpp::Error::Matches(PyObject* pExceptionType) const noexcept
+{
+    return m_pState && m_pState->pType && PyErr_GivenExceptionMatches(m_pState->pType, pExceptionType);
+}
+
+void pycpp::Error::Restore() const
+{
+    if (!m_pState || !m_pState->pType)
+    {
+        PyErr_SetString(PyExc_RuntimeError, what());
+        return;
+    }
+    Py_INCREF(m_pState->pType);
+    Py_XINCREF(m_pState->pValue);
+    Py_XINCREF(m_pState->pTraceback);
+    PyErr_Restore(m_pState->pType, m_pState->pValue, m_pState->pTraceback);
+}
+
+void pycpp::Error::Detach() const noexcept
+{
+    if (!m_pState)
+        return;
+    what();
+    WithOwnerGIL(m_pState->owner, [this] { m_pState->Release(); });
+}
+
+void pycpp::Error::ThrowCurrent()
+{
+    PyObject* pType = PyErr_Occurred();
+    if (!pType)
+        throw Error();
+    if (PyErr_GivenExceptionMatches(pType, PyExc_KeyError))
+        throw KeyError();
+    if (PyErr_GivenExceptionMatches(pType, PyExc_IndexError))
+        throw IndexError();
+    if (PyErr_GivenExceptionMatches(pType, PyExc_StopIteration))
+        throw StopIteration();
+    if (PyErr_GivenExceptionMatches(pType, PyExc_TypeError))
+        throw TypeError();
+    if (PyErr_GivenExceptionMatches(pType, PyExc_ValueError))
+        throw ValueError();
+    if (PyErr_GivenExceptionMatches(pType, PyExc_AttributeError))
+        throw AttributeError();
+    if (PyErr_GivenExceptionMatches(pType, PyExc_ImportError))
+        throw ImportError();
+    if (PyErr_GivenExceptionMatches(pType, PyExc_OverflowError))
+        throw OverflowError();
+    throw Error();
+}
+
 std::string pycpp::Error::RetrievePyErrorString()
 {
     PyObject* pyExcType;
@@ -31,3 +203,74 @@ std::string pycpp::Error::RetrievePyErrorString()
 
     return valueString + traceString;
 }
+
+pycpp::ErrorInfo pycpp::ErrorInfo::Fetch()
+{
+    ErrorInfo info;
+    info.m_pState = detail::FetchErrorState();
+    if (!info.m_pState)
+        info.m_pMessage = "Unknown Python error";
+    return info;
+}
+
+pycpp::ErrorInfo::ErrorInfo(const char* pMessage) noexcept
+    : m_pMessage(pMessage)
+{}
+
+pycpp::ErrorInfo::ErrorInfo(const Error& error, std::exception_ptr pError) noexcept
+    : m_pState(error.m_pState), m_pError(std::move(pError))
+{}
+
+// the state releases the exception objects with the GIL of their interpreter, like for Error
+pycpp::ErrorInfo::~ErrorInfo() = default;
+pycpp::ErrorInfo::ErrorInfo(const ErrorInfo& other) noexcept = default;
+pycpp::ErrorInfo& pycpp::ErrorInfo::operator=(const ErrorInfo& other) noexcept = default;
+pycpp::ErrorInfo::ErrorInfo(ErrorInfo&& other) noexcept = default;
+pycpp::ErrorInfo& pycpp::ErrorInfo::operator=(ErrorInfo&& other) noexcept = default;
+
+bool pycpp::ErrorInfo::Matches(PyObject* pExceptionType) const noexcept
+{
+    return m_pState && m_pState->pType && PyErr_GivenExceptionMatches(m_pState->pType, pExceptionType);
+}
+
+PyObject* pycpp::ErrorInfo::Type() const noexcept
+{
+    return m_pState ? m_pState->pType : nullptr;
+}
+
+void pycpp::ErrorInfo::Restore() const noexcept
+{
+    if (m_pState && m_pState->pType)
+    {
+        Py_INCREF(m_pState->pType);
+        Py_XINCREF(m_pState->pValue);
+        Py_XINCREF(m_pState->pTraceback);
+        PyErr_Restore(m_pState->pType, m_pState->pValue, m_pState->pTraceback);
+        return;
+    }
+    if (m_pError)
+    {
+        try
+        {
+            std::rethrow_exception(m_pError);
+        }
+        catch (const Error& e)
+        {
+            PyErr_SetString(PyExc_RuntimeError, e.what());
+            return;
+        }
+        catch (...)
+        {}
+    }
+    PyErr_SetString(PyExc_RuntimeError, m_pMessage ? m_pMessage : "Unknown Python error");
+}
+
+void pycpp::ErrorInfo::Throw() const
+{
+    if (m_pError)
+        std::rethrow_exception(m_pError);
+    if (!m_pState || !m_pState->pType)
+        throw Error(m_pMessage);
+    Restore();
+    Error::ThrowCurrent();
+}
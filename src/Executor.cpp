@@ -0,0 +1,105 @@
+#include "Executor.h"
+
+pycpp::detail::TaskQueue::TaskQueue() noexcept
+    : m_pHead(&m_stub), m_pTail(&m_stub)
+{}
+
+void pycpp::detail::TaskQueue::Push(ExecutorTask* pTask) noexcept
+{
+    Push(static_cast<ExecutorNode*>(pTask));
+}
+
+void pycpp::detail::TaskQueue::Push(ExecutorNode* pNode) noexcept
+{
+    pNode->pNext.store(nullptr, std::memory_order_relaxed);
+    auto* pPrev = m_pHead.exchange(pNode, std::memory_order_acq_rel);
+    // between the exchange and this store the node is not reachable by the consumer yet
+    pPrev->pNext.store(pNode, std::memory_order_release);
+}
+
+pycpp::detail::ExecutorTask* pycpp::detail::TaskQueue::Pop() noexcept
+{
+    auto* pTail = m_pTail;
+    auto* pNext = pTail->pNext.load(std::memory_order_acquire);
+    if (pTail == &m_stub)
+    {
+        if (!pNext)
+            return nullptr;
+        m_pTail = pNext;
+        pTail = pNext;
+        pNext = pNext->pNext.load(std::memory_order_acquire);
+    }
+    if (pNext)
+    {
+        m_pTail = pNext;
+        return static_cast<ExecutorTask*>(pTail);
+    }
+    if (pTail != m_pHead.load(std::memory_order_acquire))
+        return nullptr;
+    // pTail is the last node, the stub is pushed behind it so it can be handed out
+    Push(&m_stub);
+    pNext = pTail->pNext.load(std::memory_order_acquire);
+    if (pNext)
+    {
+        m_pTail = pNext;
+        return static_cast<ExecutorTask*>(pTail);
+    }
+    return nullptr;
+}
+
+pycpp::Interpreter::Executor::Executor()
+    : m_handle(Interpreter::Handle())
+{
+    m_thread = std::thread([this] { Run(); });
+}
+
+pycpp::Interpreter::Executor::~Executor()
+{
+    m_stop.store(true, std::memory_order_release);
+    m_signal.fetch_add(1, std::memory_order_release);
+    m_signal.notify_one();
+
+    // the executor needs the GIL to finish the remaining tasks
+    if (detail::HoldsGIL())
+    {
+        GILRelease release;
+        m_thread.join();
+    }
+    else
+        m_thread.join();
+}
+
+void pycpp::Interpreter::Executor::Post(detail::ExecutorTask* pTask) noexcept
+{
+    m_pending.fetch_add(1, std::memory_order_relaxed);
+    m_queue.Push(pTask);
+    m_signal.fetch_add(1, std::memory_order_release);
+    m_signal.notify_one();
+}
+
+void pycpp::Interpreter::Executor::Run() noexcept
+{
+    while (true)
+    {
+        // read before looking at the queue, so a push after an empty Pop changes it
+        const auto signal = m_signal.load(std::memory_order_acquire);
+        const bool stop = m_stop.load(std::memory_order_acquire);
+
+        if (auto* pTask = m_queue.Pop())
+        {
+            // keep the GIL for as long as there are tasks
+            GILAcquire gil;
+            do
+            {
+                pTask->Run();
+                delete pTask;
+                m_pending.fetch_sub(1, std::memory_order_relaxed);
+            } while ((pTask = m_queue.Pop()));
+            continue;
+        }
+
+        if (stop && m_pending.load(std::memory_order_acquire) == 0)
+            return;
+        m_signal.wait(signal, std::memory_order_acquire);
+    }
+}
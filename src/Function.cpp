@@ -0,0 +1,173 @@
+#include "Function.h"
+#include "Interpreter.h"
+#include <new>
+#include <stdexcept>
+
+namespace
+{
+    // The C++ side of a function, owned by the self object of the builtin function
+    struct FunctionData
+    {
+        std::unique_ptr<pycpp::detail::FunctionBase> pImpl;
+        std::string name;
+        std::string doc;
+        PyMethodDef def;
+    };
+
+    struct FunctionDataObject
+    {
+        PyObject_HEAD
+        FunctionData* pData;
+    };
+
+    PyObject* FunctionDataCall(PyObject* pSelf, PyObject* const* ppArgs, Py_ssize_t nargs)
+    {
+        auto& data = *reinterpret_cast<FunctionDataObject*>(pSelf)->pData;
+        const auto arity = data.pImpl->Arity();
+        if (nargs != arity)
+        {
+            PyErr_Format(PyExc_TypeError, "%s() takes %zd positional argument%s but %zd %s given",
+                data.name.c_str(), arity, arity == 1 ? "" : "s", nargs, nargs == 1 ? "was" : "were");
+            return nullptr;
+        }
+        return data.pImpl->Call(ppArgs);
+    }
+
+    void FunctionDataDealloc(PyObject* pSelf)
+    {
+        auto* pType = Py_TYPE(pSelf);
+        delete reinterpret_cast<FunctionDataObject*>(pSelf)->pData;
+        pType->tp_free(pSelf);
+        Py_DECREF(pType);
+    }
+
+    // Python exception for an Error raised in C++ (custom message or detached)
+    PyObject* ExceptionType(const pycpp::Error& error) noexcept
+    {
+        if (dynamic_cast<const pycpp::TypeError*>(&error))
+            return PyExc_TypeError;
+        if (dynamic_cast<const pycpp::ValueError*>(&error))
+            return PyExc_ValueError;
+        if (dynamic_cast<const pycpp::KeyError*>(&error))
+            return PyExc_KeyError;
+        if (dynamic_cast<const pycpp::IndexError*>(&error))
+            return PyExc_IndexError;
+        if (dynamic_cast<const pycpp::AttributeError*>(&error))
+            return PyExc_AttributeError;
+        if (dynamic_cast<const pycpp::ImportError*>(&error))
+            return PyExc_ImportError;
+        if (dynamic_cast<const pycpp::OverflowError*>(&error))
+            return PyExc_OverflowError;
+        if (dynamic_cast<const pycpp::StopIteration*>(&error))
+            return PyExc_StopIteration;
+        return PyExc_RuntimeError;
+    }
+
+    PyObject* FunctionDataType()
+    {
+        static pycpp::detail::InterpreterLocalRef s_type;
+        return s_type.Get([]()
+            {
+                static PyType_Slot slots[] = {
+                    { Py_tp_dealloc, reinterpret_cast<void*>(&FunctionDataDealloc) },
+                    { Py_tp_doc, const_cast<char*>("Holds the C++ callable of a pycpp.Function") },
+                    { 0, nullptr }
+                };
+                static PyType_Spec spec = {
+                    "pycpp.FunctionData",
+                    sizeof(FunctionDataObject),
+                    0,
+                    Py_TPFLAGS_DEFAULT,
+                    slots
+                };
+                pycpp::Object type = PyType_FromSpec(&spec);
+                if (!type)
+                    pycpp::Error::ThrowCurrent();
+                return type;
+            });
+    }
+}
+
+void pycpp::detail::SetCurrentException() noexcept
+{
+    try
+    {
+        throw;
+    }
+    catch (const Error& e)
+    {
+        if (e.Matches(PyExc_BaseException))
+            e.Restore();
+        else
+            PyErr_SetString(ExceptionType(e), e.what());
+    }
+    catch (const std::bad_alloc&)
+    {
+        PyErr_NoMemory();
+    }
+    catch (const std::out_of_range& e)
+    {
+        PyErr_SetString(PyExc_IndexError, e.what());
+    }
+    catch (const std::invalid_argument& e)
+    {
+        PyErr_SetString(PyExc_ValueError, e.what());
+    }
+    catch (const std::domain_error& e)
+    {
+        PyErr_SetString(PyExc_ValueError, e.what());
+    }
+    catch (const std::overflow_error& e)
+    {
+        PyErr_SetString(PyExc_OverflowError, e.what());
+    }
+    catch (const std::exception& e)
+    {
+        PyErr_SetString(PyExc_RuntimeError, e.what());
+    }
+    catch (...)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "unknown C++ exception");
+    }
+}
+
+pycpp::Object pycpp::detail::MakeFunction(std::unique_ptr<FunctionBase> pImpl, std::string name, std::string doc)
+{
+    auto* pType = reinterpret_cast<PyTypeObject*>(FunctionDataType());
+    Object self = pType->tp_alloc(pType, 0);
+    if (!self)
+        Error::ThrowCurrent();
+
+    auto* pData = new FunctionData{ std::move(pImpl), std::move(name), std::move(doc), {} };
+    reinterpret_cast<FunctionDataObject*>(self.get())->pData = pData;
+    pData->def.ml_name = pData->name.c_str();
+    // METH_FASTCALL functions take the arguments as array, the cast is the documented way to store them
+    pData->def.ml_meth = reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(&FunctionDataCall));
+    pData->def.ml_flags = METH_FASTCALL;
+    pData->def.ml_doc = pData->doc.empty() ? nullptr : pData->doc.c_str();
+
+    Object function = PyCFunction_NewEx(&pData->def, self.get(), nullptr);
+    if (!function)
+        Error::ThrowCurrent();
+    return function;
+}
+
+pycpp::Function::Function(const Function& other)
+    : Callable(other)
+{}
+
+pycpp::Function& pycpp::Function::operator=(const Function& other)
+{
+    Callable::operator=(other);
+    return *this;
+}
+
+pycpp::Function::Function(Function&& other) noexcept
+    : Callable(std::move(other))
+{}
+
+pycpp::Function& pycpp::Function::operator=(Function&& other) noexcept
+{
+    Callable::operator=(std::move(other));
+    return *this;
+}
@@ -1,20 +1,197 @@
 #include "Interpreter.h"
+#include "Error.h"
+#include <atomic>
+#include <limits>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace
+{
+    // increased on each initialization of Python, see detail::InterpreterKey
+    std::atomic<uint64_t> s_generation{ 0 };
+
+    std::mutex s_stateMutex{};
+    std::map<pycpp::detail::InterpreterKey, pycpp::detail::InterpreterState> s_interpreterStates{};
+    // interpreters of the current generation whose state was released, guarded by s_stateMutex
+    std::set<pycpp::detail::InterpreterKey> s_endedInterpreters{};
+
+    // last state used by this thread, so the common case does not need to lock
+    thread_local pycpp::detail::InterpreterKey t_stateKey{};
+    thread_local pycpp::detail::InterpreterState* t_pState = nullptr;
+}
 
 size_t pycpp::Interpreter::s_refCnt = 0;
+std::mutex pycpp::Interpreter::s_refMutex{};
 std::mutex pycpp::Interpreter::s_mutex{};
 std::unique_ptr<pycpp::detail::PyInstance> pycpp::Interpreter::s_pInterpreter{};
 
 pycpp::detail::PyInstance::PyInstance()
 {
     Py_Initialize();
+    ++s_generation;
+    m_pMainThreadState = PyThreadState_Get();
     // TODO handle failure of initialization
 }
 
 pycpp::detail::PyInstance::~PyInstance()
 {
+    // the last handle might be closed from a thread that does not hold the GIL
+    if (!HoldsGIL())
+        PyEval_RestoreThread(m_pMainThreadState);
+    ReleaseInterpreterState();
     Py_Finalize();
 }
 
+bool pycpp::detail::HoldsGIL() noexcept
+{
+#if PY_VERSION_HEX >= 0x030D0000
+    return PyThreadState_GetUnchecked() != nullptr;
+#elif PY_VERSION_HEX >= 0x030C0000
+    return _PyThreadState_UncheckedGet() != nullptr;
+#else
+    // before 3.12 the current thread state is global, it is the one of whichever thread holds the GIL
+    const auto* pThreadState = _PyThreadState_UncheckedGet();
+    return pThreadState && pThreadState->thread_id == PyThread_get_thread_ident();
+#endif
+}
+
+pycpp::detail::InterpreterKey pycpp::detail::CurrentInterpreterKey() noexcept
+{
+    return { s_generation.load(std::memory_order_relaxed), PyInterpreterState_GetID(PyInterpreterState_Get()) };
+}
+
+bool pycpp::detail::IsCurrentInterpreter(const InterpreterKey& key) noexcept
+{
+    return key.generation == s_generation.load(std::memory_order_relaxed) && HoldsGIL() && CurrentInterpreterKey() == key;
+}
+
+bool pycpp::detail::IsMainInterpreterAlive(const InterpreterKey& key) noexcept
+{
+    // the main interpreter always has the id 0
+    return key.id == 0 && key.generation == s_generation.load(std::memory_order_relaxed) && Py_IsInitialized();
+}
+
+bool pycpp::detail::IsInterpreterEnded(const InterpreterKey& key)
+{
+    if (key.generation != s_generation.load(std::memory_order_relaxed) || !Py_IsInitialized())
+        return true;
+    std::lock_guard<std::mutex> lock(s_stateMutex);
+    return s_endedInterpreters.count(key) != 0;
+}
+
+pycpp::detail::InterpreterState& pycpp::detail::CurrentInterpreterState()
+{
+    const auto key = CurrentInterpreterKey();
+    if (t_pState && t_stateKey == key)
+        return *t_pState;
+
+    std::lock_guard<std::mutex> lock(s_stateMutex);
+    t_pState = &s_interpreterStates[key];
+    t_stateKey = key;
+    return *t_pState;
+}
+
+void pycpp::detail::ReleaseInterpreterState()
+{
+    const auto key = CurrentInterpreterKey();
+    InterpreterState state;
+    {
+        std::lock_guard<std::mutex> lock(s_stateMutex);
+        // keys of earlier generations are ended anyway
+        s_endedInterpreters.erase(s_endedInterpreters.begin(), s_endedInterpreters.lower_bound({ key.generation, std::numeric_limits<int64_t>::min() }));
+        s_endedInterpreters.insert(key);
+
+        auto it = s_interpreterStates.find(key);
+        if (it == s_interpreterStates.end())
+            return;
+        state = std::move(it->second);
+        s_interpreterStates.erase(it);
+    }
+    if (t_stateKey == key)
+        t_pState = nullptr;
+    // the cached objects are released when state goes out of scope, outside of the lock
+}
+
+pycpp::detail::InterpreterLocalRef::~InterpreterLocalRef()
+{
+    auto* pNode = m_pHead.load(std::memory_order_acquire);
+    while (pNode)
+    {
+        if (IsCurrentInterpreter({ pNode->generation.load(std::memory_order_relaxed), pNode->id.load(std::memory_order_relaxed) }))
+            Py_DECREF(pNode->pObject.load(std::memory_order_relaxed));
+        auto* pNext = pNode->pNext;
+        delete pNode;
+        pNode = pNext;
+    }
+}
+
+pycpp::detail::InterpreterLocalRef::InterpreterLocalRef(const InterpreterLocalRef&) noexcept
+{}
+
+pycpp::detail::InterpreterLocalRef& pycpp::detail::InterpreterLocalRef::operator=(const InterpreterLocalRef&) noexcept
+{
+    return *this;
+}
+
+PyObject* pycpp::detail::InterpreterLocalRef::Find(const InterpreterKey& key) const noexcept
+{
+    // A node is only ever set to key by a thread holding the GIL of that interpreter, so while it is
+    // being reused for another interpreter, the mix of its old and new key never matches key
+    for (auto* pNode = m_pHead.load(std::memory_order_acquire); pNode; pNode = pNode->pNext)
+    {
+        if (pNode->generation.load(std::memory_order_acquire) == key.generation && pNode->id.load(std::memory_order_relaxed) == key.id)
+            return pNode->pObject.load(std::memory_order_relaxed);
+    }
+    return nullptr;
+}
+
+PyObject* pycpp::detail::InterpreterLocalRef::Insert(const InterpreterKey& key, Object object) const
+{
+    // only the thread holding the GIL of this interpreter gets here, so there is no other node for key
+    auto* pObject = object.ReleaseOwnership();
+    for (auto* pNode = m_pHead.load(std::memory_order_acquire); pNode; pNode = pNode->pNext)
+    {
+        if (TryReuse(pNode, key, pObject))
+            return pObject;
+    }
+
+    auto* pNode = new Node{ key.generation, key.id, pObject, m_pHead.load(std::memory_order_relaxed) };
+    while (!m_pHead.compare_exchange_weak(pNode->pNext, pNode, std::memory_order_release, std::memory_order_relaxed))
+    {}
+    return pObject;
+}
+
+bool pycpp::detail::InterpreterLocalRef::TryReuse(Node* pNode, const InterpreterKey& key, PyObject* pObject)
+{
+    auto generation = pNode->generation.load(std::memory_order_relaxed);
+    if (generation == 0 || !IsInterpreterEnded({ generation, pNode->id.load(std::memory_order_relaxed) }))
+        return false;
+    // claim the node, so no other interpreter reuses it at the same time
+    if (!pNode->generation.compare_exchange_strong(generation, 0, std::memory_order_acquire, std::memory_order_relaxed))
+        return false;
+    // the id might have changed between the check and the claim
+    if (!IsInterpreterEnded({ generation, pNode->id.load(std::memory_order_relaxed) }))
+    {
+        pNode->generation.store(generation, std::memory_order_release);
+        return false;
+    }
+
+    // the object of the ended interpreter can't be released anymore and is dropped
+    pNode->id.store(key.id, std::memory_order_relaxed);
+    pNode->pObject.store(pObject, std::memory_order_relaxed);
+    pNode->generation.store(key.generation, std::memory_order_release);
+    return true;
+}
+
+size_t pycpp::detail::InterpreterLocalRef::SlotCount() const noexcept
+{
+    size_t count = 0;
+    for (auto* pNode = m_pHead.load(std::memory_order_acquire); pNode; pNode = pNode->pNext)
+        ++count;
+    return count;
+}
+
 pycpp::InterpreterHandle::InterpreterHandle()
 {
     Interpreter::Open();
@@ -79,6 +256,7 @@ bool pycpp::InterpreterHandle::Aqurired() noexcept
 
 void pycpp::Interpreter::Open()
 {
+    std::lock_guard<std::mutex> lock(s_refMutex);
     if (s_refCnt == 0)
     {
         s_pInterpreter = std::make_unique<detail::PyInstance>();
@@ -88,6 +266,7 @@ void pycpp::Interpreter::Open()
 
 void pycpp::Interpreter::Close()
 {
+    std::lock_guard<std::mutex> lock(s_refMutex);
     if (s_refCnt > 0)
         --s_refCnt;
     if (s_refCnt == 0 && s_pInterpreter)
@@ -101,8 +280,114 @@ pycpp::InterpreterHandle pycpp::Interpreter::Handle()
     return InterpreterHandle();
 }
 
-[[nodiscard]]
-auto pycpp::Interpreter::getLock()
+std::unique_lock<std::mutex> pycpp::Interpreter::getLock()
 {
     return std::unique_lock<decltype(s_mutex)>(s_mutex);
 }
+
+namespace
+{
+    // Thread states of exited threads. A thread can't wait for the GIL while it exits (the thread
+    // joining it may hold the GIL), so its state is deleted by the next thread that takes the GIL
+    std::mutex s_orphanMutex{};
+    std::vector<PyThreadState*> s_orphanedStates{};
+    uint64_t s_orphanGeneration = 0;
+    std::atomic<bool> s_hasOrphans{ false };
+
+    void OrphanThreadState(PyThreadState* pThreadState, uint64_t generation)
+    {
+        std::lock_guard<std::mutex> lock(s_orphanMutex);
+        if (s_orphanGeneration != generation)
+        {
+            // states of a finalized interpreter were deleted with it
+            s_orphanedStates.clear();
+            s_orphanGeneration = generation;
+        }
+        s_orphanedStates.push_back(pThreadState);
+        s_hasOrphans.store(true, std::memory_order_release);
+    }
+
+    // Deletes the orphaned thread states. The calling thread has to hold the GIL of the main interpreter
+    void DeleteOrphanedThreadStates() noexcept
+    {
+        if (!s_hasOrphans.load(std::memory_order_acquire))
+            return;
+        if (PyThreadState_GetInterpreter(PyThreadState_Get()) != PyInterpreterState_Main())
+            return;
+
+        std::vector<PyThreadState*> orphans;
+        {
+            std::lock_guard<std::mutex> lock(s_orphanMutex);
+            if (s_orphanGeneration == s_generation.load(std::memory_order_relaxed))
+                orphans.swap(s_orphanedStates);
+            else
+                s_orphanedStates.clear();
+            s_hasOrphans.store(false, std::memory_order_relaxed);
+        }
+        for (auto* pThreadState : orphans)
+        {
+            PyThreadState_Clear(pThreadState);
+            PyThreadState_Delete(pThreadState);
+        }
+    }
+
+    // PyThreadState of a thread that is not the one which initialized Python. Created on
+    // first use, reused by every GILAcquire of the thread and deleted when the thread exits
+    struct CachedThreadState
+    {
+        PyThreadState* pThreadState = nullptr;
+        uint64_t generation = 0;
+
+        PyThreadState* Get()
+        {
+            const auto generation = s_generation.load(std::memory_order_relaxed);
+            if (pThreadState && this->generation == generation)
+                return pThreadState;
+            // thread states of a finalized interpreter are already gone
+            pThreadState = PyThreadState_New(PyInterpreterState_Main());
+            if (!pThreadState)
+                throw pycpp::Error("Failed to create PyThreadState");
+            this->generation = generation;
+            return pThreadState;
+        }
+
+        ~CachedThreadState()
+        {
+            if (!pThreadState || generation != s_generation.load(std::memory_order_relaxed) || !Py_IsInitialized())
+                return;
+            OrphanThreadState(pThreadState, generation);
+        }
+    };
+
+    thread_local CachedThreadState t_threadState{};
+}
+
+pycpp::GILAcquire::GILAcquire()
+{
+    if (detail::HoldsGIL())
+        return;
+    // a thread that released the GIL with PyEval_SaveThread gets its own state back through
+    // PyGILState, any other thread uses its cached state
+    auto* pThreadState = PyGILState_GetThisThreadState();
+    if (!pThreadState)
+        pThreadState = t_threadState.Get();
+    PyEval_RestoreThread(pThreadState);
+    m_acquired = true;
+    DeleteOrphanedThreadStates();
+}
+
+pycpp::GILAcquire::~GILAcquire()
+{
+    if (m_acquired)
+        PyEval_SaveThread();
+}
+
+pycpp::GILRelease::GILRelease()
+    : m_pThreadState(PyEval_SaveThread())
+{}
+
+pycpp::GILRelease::~GILRelease()
+{
+    PyEval_RestoreThread(m_pThreadState);
+    DeleteOrphanedThreadStates();
+}
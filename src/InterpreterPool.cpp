@@ -0,0 +1,300 @@
+#include "InterpreterPool.h"
+#include "Error.h"
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+struct pycpp::detail::PoolWorker
+{
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::deque<std::function<void()>> tasks;
+    bool stop = false;
+    std::atomic<size_t> pending{ 0 };
+    InterpreterKey key{};
+
+    void Post(std::function<void()> task)
+    {
+        ++pending;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+        wakeUp.notify_one();
+    }
+
+    void Run(std::promise<void>& started);
+};
+
+namespace
+{
+    // workers by the interpreter they run, so references can be released in their interpreter
+    std::mutex s_workersMutex{};
+    std::map<pycpp::detail::InterpreterKey, pycpp::detail::PoolWorker*> s_workers{};
+
+    PyThreadState* NewSubInterpreter()
+    {
+        PyThreadState* pThreadState = nullptr;
+#if PY_VERSION_HEX >= 0x030C0000
+        // an own GIL requires an own allocator, which in turn requires the isolation checks of extensions
+        PyInterpreterConfig config{};
+        config.use_main_obmalloc = 0;
+        config.allow_fork = 0;
+        config.allow_exec = 0;
+        config.allow_threads = 1;
+        config.allow_daemon_threads = 0;
+        config.check_multi_interp_extensions = 1;
+        config.gil = PyInterpreterConfig_OWN_GIL;
+        const auto status = Py_NewInterpreterFromConfig(&pThreadState, &config);
+        if (PyStatus_Exception(status))
+            throw pycpp::Error(std::string("Failed to create sub-interpreter: ") + (status.err_msg ? status.err_msg : "unknown error"));
+#else
+        pThreadState = Py_NewInterpreter();
+#endif
+        if (!pThreadState)
+            throw pycpp::Error("Failed to create sub-interpreter");
+        return pThreadState;
+    }
+}
+
+void pycpp::detail::PoolWorker::Run(std::promise<void>& started)
+{
+    // the sub-interpreter is created from a thread state of the main interpreter, which is
+    // swapped out (and with an own GIL, the main GIL released) once the new one is current
+    auto* pMainState = PyThreadState_New(PyInterpreterState_Main());
+    PyEval_RestoreThread(pMainState);
+    PyThreadState* pSubState = nullptr;
+    try
+    {
+        pSubState = NewSubInterpreter();
+    }
+    catch (...)
+    {
+        PyThreadState_Clear(pMainState);
+        PyThreadState_DeleteCurrent();
+        started.set_exception(std::current_exception());
+        return;
+    }
+
+    key = CurrentInterpreterKey();
+    {
+        std::lock_guard<std::mutex> lock(s_workersMutex);
+        s_workers[key] = this;
+    }
+    PyEval_SaveThread();
+    started.set_value();
+
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this] { return stop || !tasks.empty(); });
+            // pending tasks are finished before stopping
+            if (tasks.empty())
+                break;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        PyEval_RestoreThread(pSubState);
+        task();
+        task = nullptr; // captures are released within the interpreter
+        PyEval_SaveThread();
+        --pending;
+    }
+
+    PyEval_RestoreThread(pSubState);
+    {
+        // releases posted from now on are dropped
+        std::lock_guard<std::mutex> lock(s_workersMutex);
+        s_workers.erase(key);
+    }
+    // run releases that were posted before the worker was unregistered
+    std::deque<std::function<void()>> remaining;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        remaining.swap(tasks);
+    }
+    for (auto& task : remaining)
+        task();
+    remaining.clear();
+    ReleaseInterpreterState();
+    Py_EndInterpreter(pSubState);
+
+#if PY_VERSION_HEX >= 0x030C0000
+    // the own GIL is gone with the interpreter
+    PyEval_RestoreThread(pMainState);
+#else
+    // the shared GIL is still held
+    PyThreadState_Swap(pMainState);
+#endif
+    PyThreadState_Clear(pMainState);
+    PyThreadState_DeleteCurrent();
+}
+
+pycpp::PinnedObject::PinnedObject(Object object)
+    : m_pObject(object.ReleaseOwnership()), m_owner(detail::CurrentInterpreterKey())
+{}
+
+pycpp::PinnedObject::~PinnedObject()
+{
+    Release();
+}
+
+pycpp::PinnedObject::PinnedObject(PinnedObject&& other) noexcept
+    : m_pObject(other.m_pObject), m_owner(other.m_owner)
+{
+    other.m_pObject = nullptr;
+}
+
+pycpp::PinnedObject& pycpp::PinnedObject::operator=(PinnedObject&& other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        m_pObject = other.m_pObject;
+        m_owner = other.m_owner;
+        other.m_pObject = nullptr;
+    }
+    return *this;
+}
+
+pycpp::Object pycpp::PinnedObject::get() const
+{
+    if (!m_pObject)
+        return Object();
+    if (!detail::IsCurrentInterpreter(m_owner))
+        throw Error("PinnedObject used outside of the interpreter it belongs to");
+    return Object::BorrowedRef(m_pObject);
+}
+
+void pycpp::PinnedObject::Release() noexcept
+{
+    auto* pObject = m_pObject;
+    m_pObject = nullptr;
+    if (!pObject)
+        return;
+    if (detail::IsCurrentInterpreter(m_owner))
+    {
+        Py_DECREF(pObject);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(s_workersMutex);
+    auto it = s_workers.find(m_owner);
+    if (it == s_workers.end())
+        return;
+    try
+    {
+        it->second->Post([pObject]() { Py_DECREF(pObject); });
+    }
+    catch (...)
+    {
+        // out of memory, the reference is dropped
+    }
+}
+
+pycpp::InterpreterPool::InterpreterPool(size_t size)
+{
+    if (size == 0)
+        throw Error("InterpreterPool: size must not be zero");
+
+    // the workers need the main GIL to create their interpreters
+    std::optional<GILRelease> release;
+    if (detail::HoldsGIL())
+        release.emplace();
+
+    m_workers.reserve(size);
+    try
+    {
+        for (size_t idx = 0; idx < size; ++idx)
+        {
+            auto& worker = *m_workers.emplace_back(std::make_unique<detail::PoolWorker>());
+            std::promise<void> started;
+            auto startedFuture = started.get_future();
+            worker.thread = std::thread([&worker, &started] { worker.Run(started); });
+            try
+            {
+                startedFuture.get();
+            }
+            catch (...)
+            {
+                worker.thread.join();
+                m_workers.pop_back();
+                throw;
+            }
+        }
+    }
+    catch (...)
+    {
+        Shutdown();
+        throw;
+    }
+}
+
+pycpp::InterpreterPool::~InterpreterPool()
+{
+    if (m_workers.empty())
+        return;
+
+    // the workers need the main GIL to clean up
+    std::optional<GILRelease> release;
+    if (detail::HoldsGIL())
+        release.emplace();
+    Shutdown();
+}
+
+void pycpp::InterpreterPool::Shutdown() noexcept
+{
+    for (auto& pWorker : m_workers)
+    {
+        {
+            std::lock_guard<std::mutex> lock(pWorker->mutex);
+            pWorker->stop = true;
+        }
+        pWorker->wakeUp.notify_one();
+    }
+    for (auto& pWorker : m_workers)
+        pWorker->thread.join();
+    m_workers.clear();
+}
+
+const pycpp::detail::InterpreterKey& pycpp::InterpreterPool::Key(size_t worker) const
+{
+    return m_workers.at(worker)->key;
+}
+
+void pycpp::InterpreterPool::Post(size_t worker, std::function<void()> task)
+{
+    m_workers.at(worker)->Post(std::move(task));
+}
+
+size_t pycpp::InterpreterPool::LeastBusyWorker() const noexcept
+{
+    size_t best = 0;
+    auto bestPending = m_workers[0]->pending.load(std::memory_order_relaxed);
+    for (size_t idx = 1; idx < m_workers.size() && bestPending > 0; ++idx)
+    {
+        const auto pending = m_workers[idx]->pending.load(std::memory_order_relaxed);
+        if (pending < bestPending)
+        {
+            best = idx;
+            bestPending = pending;
+        }
+    }
+    return best;
+}
+
+size_t pycpp::InterpreterPool::WorkerOf(const detail::InterpreterKey& owner) const
+{
+    for (size_t idx = 0; idx < m_workers.size(); ++idx)
+    {
+        if (m_workers[idx]->key == owner)
+            return idx;
+    }
+    throw Error("InterpreterPool: the interpreter does not belong to this pool");
+}
@@ -0,0 +1,107 @@
+#include "Module.h"
+#include "Utilities.h"
+
+pycpp::Object pycpp::ModuleCache::Import(std::string_view name)
+{
+    return TryImport(name).value();
+}
+
+pycpp::Result<pycpp::Object> pycpp::ModuleCache::TryImport(std::string_view name)
+{
+    auto& modules = detail::CurrentInterpreterState().modules;
+    const auto it = modules.find(name);
+    if (it != modules.end())
+        return it->second;
+
+    std::string key(name);
+    Object module = PyImport_ImportModule(key.c_str());
+    if (!module)
+        return ErrorInfo::Fetch();
+    modules.emplace(std::move(key), module);
+    return module;
+}
+
+pycpp::LazyModule::LazyModule(std::string name)
+    : m_name(std::move(name))
+{}
+
+pycpp::Object pycpp::LazyModule::Get() const
+{
+    return Object::BorrowedRef(Module());
+}
+
+pycpp::Object pycpp::LazyModule::GetAttribute(const char* attribute) const
+{
+    return GetAttributeString(Module(), attribute);
+}
+
+pycpp::Object pycpp::LazyModule::GetAttribute(const std::string& attribute) const
+{
+    return GetAttributeString(Module(), attribute);
+}
+
+pycpp::Object pycpp::LazyModule::GetAttribute(const AttributeName& attribute) const
+{
+    return GetAttributeString(Module(), attribute);
+}
+
+const std::string& pycpp::LazyModule::Name() const noexcept
+{
+    return m_name;
+}
+
+PyObject* pycpp::LazyModule::Module() const
+{
+    return m_module.Get([this]() { return ModuleCache::Import(m_name); });
+}
+
+pycpp::ModulePrewarm::ModulePrewarm(std::vector<std::string> modules)
+    : m_handle(Interpreter::Handle()), m_modules(std::move(modules))
+{
+    m_thread = std::thread([this] { Run(); });
+}
+
+pycpp::ModulePrewarm::~ModulePrewarm()
+{
+    Join();
+}
+
+void pycpp::ModulePrewarm::Wait()
+{
+    Join();
+    if (m_pError)
+        std::rethrow_exception(std::exchange(m_pError, nullptr));
+}
+
+void pycpp::ModulePrewarm::Run() noexcept
+{
+    for (const auto& name : m_modules)
+    {
+        // the GIL is released between modules, so other threads get to run in between
+        GILAcquire gil;
+        try
+        {
+            detail::DetachErrors([&]() { (void)ModuleCache::Import(name); });
+        }
+        catch (...)
+        {
+            if (!m_pError)
+                m_pError = std::current_exception();
+        }
+    }
+}
+
+void pycpp::ModulePrewarm::Join()
+{
+    if (!m_thread.joinable())
+        return;
+
+    // the imports need the GIL
+    if (detail::HoldsGIL())
+    {
+        GILRelease release;
+        m_thread.join();
+    }
+    else
+        m_thread.join();
+}
@@ -1,5 +1,7 @@
 #include "Object.h"
 #include "Error.h"
+#include "Result.h"
+#include "AttributeName.h"
 
 pycpp::Object::Object(std::nullptr_t) noexcept
 {}
@@ -76,6 +78,13 @@ pycpp::Object::operator bool() const noexcept
     return m_pObject != nullptr;
 }
 
+PyObject* pycpp::Object::ReleaseOwnership() noexcept
+{
+    auto* pObject = m_pObject;
+    m_pObject = nullptr;
+    return pObject;
+}
+
 void pycpp::Object::Release()
 {
     if (m_pObject)
@@ -102,27 +111,74 @@ std::string pycpp::Object::StringRepr() noexcept
     return std::string(PyBytes_AsString(pyStr.get()));
 }
 
-bool pycpp::Object::HasAttribute(const char* attribute) noexcept
+bool pycpp::Object::HasAttribute(const char* attribute) const noexcept
+{
+    const auto name = detail::NameObject(attribute);
+    if (!name)
+    {
+        PyErr_Clear();
+        return false;
+    }
+    return PyObject_HasAttr(m_pObject, name.get()) == 1;
+}
+
+bool pycpp::Object::HasAttribute(const std::string& str) const noexcept
+{
+    return HasAttribute(str.c_str());
+}
+
+bool pycpp::Object::HasAttribute(const AttributeName& attribute) const noexcept
+{
+    try
+    {
+        return PyObject_HasAttr(m_pObject, attribute.Get()) == 1;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+pycpp::Object pycpp::Object::GetAttribute(const char* attribute) const
+{
+    return TryGetAttribute(attribute).value();
+}
+
+pycpp::Object pycpp::Object::GetAttribute(const std::string& str) const
+{
+    return TryGetAttribute(str).value();
+}
+
+pycpp::Object pycpp::Object::GetAttribute(const AttributeName& attribute) const
 {
-    return PyObject_HasAttrString(m_pObject, attribute) == 1;
+    return TryGetAttribute(attribute).value();
 }
 
-bool pycpp::Object::HasAttribute(const std::string& str) noexcept
+pycpp::Result<pycpp::Object> pycpp::Object::TryGetAttribute(const char* attribute) const
 {
-    return PyObject_HasAttrString(m_pObject, str.c_str()) == 1;
+    const auto name = detail::NameObject(attribute);
+    if (!name)
+        return ErrorInfo::Fetch();
+    Object result = PyObject_GetAttr(m_pObject, name.get());
+    if (!result)
+        return ErrorInfo::Fetch();
+    return result;
 }
 
-pycpp::Object pycpp::Object::GetAttribute(const char* attribute)
+pycpp::Result<pycpp::Object> pycpp::Object::TryGetAttribute(const std::string& str) const
 {
-    auto pRes = PyObject_GetAttrString(m_pObject, attribute);
-    if (!pRes)
-        throw(Error());
-    return Object(pRes);
+    return TryGetAttribute(str.c_str());
 }
 
-pycpp::Object pycpp::Object::GetAttribute(const std::string& str)
+pycpp::Result<pycpp::Object> pycpp::Object::TryGetAttribute(const AttributeName& attribute) const
 {
-    return GetAttribute(str.c_str());
+    return detail::CatchErrors<Object>([&]() -> Result<Object>
+        {
+            Object result = PyObject_GetAttr(m_pObject, attribute.Get());
+            if (!result)
+                return ErrorInfo::Fetch();
+            return result;
+        });
 }
 
 pycpp::Object pycpp::Object::BorrowedRef(PyObject* pPyObj)
@@ -0,0 +1,590 @@
+#include "ProcessPool.h"
+
+#ifndef _WIN32
+
+#include "Interpreter.h"
+#include "AttributeName.h"
+#include "Callable.h"
+#include "Utilities.h"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+namespace
+{
+    // written in place of a message length when the message does not fit before the end of the ring
+    constexpr uint64_t s_wrapMarker = UINT64_MAX;
+
+    constexpr uint64_t PaddedSize(uint64_t size) noexcept
+    {
+        return (size + 7) & ~uint64_t(7);
+    }
+
+    struct RingHeader
+    {
+        // number of messages that can be read
+        sem_t available;
+        // positions only ever grow, the offset into the data is position % capacity
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+        uint64_t capacity;
+    };
+
+    // Single-producer single-consumer queue of messages in memory shared by the pool and one
+    // worker. Each message is its length followed by the payload, padded to 8 bytes
+    class SharedRing
+    {
+    public:
+        explicit SharedRing(size_t capacity)
+        {
+            static std::atomic<unsigned> s_counter{ 0 };
+            const auto name = "/pycpp-" + std::to_string(getpid()) + "-" + std::to_string(s_counter++);
+
+            capacity = PaddedSize(capacity);
+            m_size = sizeof(RingHeader) + capacity;
+            const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0)
+                throw pycpp::Error("ProcessPool: shm_open failed: " + std::string(strerror(errno)));
+            // the mapping stays valid after unlinking, and nothing is left behind if a process crashes
+            shm_unlink(name.c_str());
+            if (ftruncate(fd, static_cast<off_t>(m_size)) < 0)
+            {
+                close(fd);
+                throw pycpp::Error("ProcessPool: ftruncate failed: " + std::string(strerror(errno)));
+            }
+            void* pMemory = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (pMemory == MAP_FAILED)
+                throw pycpp::Error("ProcessPool: mmap failed: " + std::string(strerror(errno)));
+
+            m_pHeader = new (pMemory) RingHeader;
+            m_pData = reinterpret_cast<std::byte*>(m_pHeader + 1);
+            m_pHeader->head.store(0, std::memory_order_relaxed);
+            m_pHeader->tail.store(0, std::memory_order_relaxed);
+            m_pHeader->capacity = capacity;
+            if (sem_init(&m_pHeader->available, 1, 0) < 0)
+            {
+                munmap(pMemory, m_size);
+                throw pycpp::Error("ProcessPool: sem_init failed: " + std::string(strerror(errno)));
+            }
+        }
+
+        ~SharedRing()
+        {
+            sem_destroy(&m_pHeader->available);
+            munmap(m_pHeader, m_size);
+        }
+
+        SharedRing(const SharedRing& other) = delete;
+        SharedRing& operator=(const SharedRing& other) = delete;
+
+        // Largest payload that always fits, with room for skipping the end of the ring
+        [[nodiscard]] size_t MaxMessageSize() const noexcept
+        {
+            return m_pHeader->capacity / 2 - sizeof(uint64_t);
+        }
+
+        // Appends a message, waiting while the ring is full. Returns false if cancel returned true
+        // while waiting
+        template<typename Cancel>
+        bool Write(std::span<const std::byte> message, Cancel&& cancel)
+        {
+            if (message.size() > MaxMessageSize())
+                throw pycpp::Error("ProcessPool: message of " + std::to_string(message.size()) + " bytes does not fit into the ring");
+
+            const auto capacity = m_pHeader->capacity;
+            const auto recordSize = sizeof(uint64_t) + PaddedSize(message.size());
+            auto head = m_pHeader->head.load(std::memory_order_relaxed);
+            const auto offset = head % capacity;
+            const auto skip = capacity - offset < recordSize ? capacity - offset : 0;
+
+            for (unsigned spin = 0; capacity - (head - m_pHeader->tail.load(std::memory_order_acquire)) < skip + recordSize; ++spin)
+            {
+                if (cancel())
+                    return false;
+                if (spin < 64)
+                    sched_yield();
+                else
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+
+            if (skip > 0)
+            {
+                std::memcpy(m_pData + offset, &s_wrapMarker, sizeof(uint64_t));
+                head += skip;
+            }
+            const uint64_t size = message.size();
+            auto* pRecord = m_pData + head % capacity;
+            std::memcpy(pRecord, &size, sizeof(uint64_t));
+            if (!message.empty())
+                std::memcpy(pRecord + sizeof(uint64_t), message.data(), message.size());
+            m_pHeader->head.store(head + recordSize, std::memory_order_release);
+            sem_post(&m_pHeader->available);
+            return true;
+        }
+
+        // Waits for the next message. Returns false if there was none within timeout
+        bool Read(std::vector<std::byte>& message, std::chrono::milliseconds timeout)
+        {
+            timespec deadline{};
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            const auto nanoseconds = deadline.tv_nsec + std::chrono::nanoseconds(timeout).count();
+            deadline.tv_sec += static_cast<time_t>(nanoseconds / 1000000000);
+            deadline.tv_nsec = static_cast<long>(nanoseconds % 1000000000);
+
+            while (sem_timedwait(&m_pHeader->available, &deadline) < 0)
+            {
+                if (errno != EINTR)
+                    return false;
+            }
+            Take(message);
+            return true;
+        }
+
+        // Waits for the next message without a timeout
+        void Read(std::vector<std::byte>& message)
+        {
+            while (sem_wait(&m_pHeader->available) < 0)
+            {}
+            Take(message);
+        }
+
+        // Returns false instead of waiting if there is no message
+        bool TryRead(std::vector<std::byte>& message)
+        {
+            if (sem_trywait(&m_pHeader->available) < 0)
+                return false;
+            Take(message);
+            return true;
+        }
+
+    private:
+        void Take(std::vector<std::byte>& message)
+        {
+            const auto capacity = m_pHeader->capacity;
+            auto tail = m_pHeader->tail.load(std::memory_order_relaxed);
+            uint64_t size = 0;
+            std::memcpy(&size, m_pData + tail % capacity, sizeof(uint64_t));
+            if (size == s_wrapMarker)
+            {
+                tail += capacity - tail % capacity;
+                std::memcpy(&size, m_pData, sizeof(uint64_t));
+            }
+            const auto* pPayload = m_pData + tail % capacity + sizeof(uint64_t);
+            message.assign(pPayload, pPayload + size);
+            m_pHeader->tail.store(tail + sizeof(uint64_t) + PaddedSize(size), std::memory_order_release);
+        }
+
+        RingHeader* m_pHeader = nullptr;
+        std::byte* m_pData = nullptr;
+        size_t m_size = 0;
+    };
+
+    // Resolves "package.module.attribute" by importing the longest module prefix
+    pycpp::Object ResolveFunction(const std::string& path)
+    {
+        auto end = path.rfind('.');
+        while (end != std::string::npos)
+        {
+            pycpp::Object module = PyImport_ImportModule(path.substr(0, end).c_str());
+            if (module)
+            {
+                pycpp::Object result = module;
+                size_t begin = end + 1;
+                while (begin <= path.size())
+                {
+                    auto next = path.find('.', begin);
+                    if (next == std::string::npos)
+                        next = path.size();
+                    result = result.GetAttribute(path.substr(begin, next - begin));
+                    begin = next + 1;
+                }
+                return result;
+            }
+            // only keep looking if the prefix is not a module, not if importing it failed
+            if (!PyErr_ExceptionMatches(PyExc_ModuleNotFoundError))
+                pycpp::Error::ThrowCurrent();
+            PyErr_Clear();
+            end = path.rfind('.', end - 1);
+            if (end == 0)
+                break;
+        }
+        throw pycpp::Error("ProcessPool: " + path + " is not of the form module.function");
+    }
+
+    pycpp::Object ReadArgument(pycpp::detail::WireReader& reader)
+    {
+        using pycpp::detail::WireTag;
+        pycpp::Object result;
+        switch (reader.Tag())
+        {
+        case WireTag::None:
+            return pycpp::Object::BorrowedRef(Py_None);
+        case WireTag::Bool:
+            return pycpp::Object::BorrowedRef(reader.Raw<uint8_t>() ? Py_True : Py_False);
+        case WireTag::Int:
+            result = PyLong_FromLongLong(reader.Raw<int64_t>());
+            break;
+        case WireTag::Float:
+            result = PyFloat_FromDouble(reader.Raw<double>());
+            break;
+        case WireTag::Str:
+        {
+            const auto str = reader.String();
+            result = PyUnicode_DecodeUTF8(str.data(), static_cast<Py_ssize_t>(str.size()), nullptr);
+            break;
+        }
+        case WireTag::Bytes:
+        {
+            const auto str = reader.String();
+            result = PyBytes_FromStringAndSize(str.data(), static_cast<Py_ssize_t>(str.size()));
+            break;
+        }
+        case WireTag::Buffer:
+        {
+            const auto buffer = reader.Buffer();
+            pycpp::Object bytes = PyByteArray_FromStringAndSize(reinterpret_cast<const char*>(buffer.pData), static_cast<Py_ssize_t>(buffer.size));
+            if (!bytes)
+                pycpp::Error::ThrowCurrent();
+            pycpp::Object view = PyMemoryView_FromObject(bytes.get());
+            if (!view)
+                pycpp::Error::ThrowCurrent();
+            return pycpp::detail::InvokeMethod(PYCPP_NAME("cast").Get(), view, std::string(buffer.format));
+        }
+        default:
+            throw pycpp::Error("ProcessPool: invalid argument");
+        }
+        if (!result)
+            pycpp::Error::ThrowCurrent();
+        return result;
+    }
+
+    void WriteResult(pycpp::detail::WireWriter& writer, PyObject* pResult)
+    {
+        using pycpp::detail::WireTag;
+        if (pResult == Py_None)
+            writer.Tag(WireTag::None);
+        else if (PyBool_Check(pResult))
+        {
+            writer.Tag(WireTag::Bool);
+            writer.Raw(static_cast<uint8_t>(pResult == Py_True));
+        }
+        else if (PyLong_Check(pResult))
+        {
+            const long long value = PyLong_AsLongLong(pResult);
+            if (value == -1 && PyErr_Occurred())
+                pycpp::Error::ThrowCurrent();
+            writer.Tag(WireTag::Int);
+            writer.Raw(static_cast<int64_t>(value));
+        }
+        else if (PyFloat_Check(pResult))
+        {
+            writer.Tag(WireTag::Float);
+            writer.Raw(PyFloat_AS_DOUBLE(pResult));
+        }
+        else if (PyUnicode_Check(pResult))
+        {
+            Py_ssize_t size = 0;
+            const char* pData = PyUnicode_AsUTF8AndSize(pResult, &size);
+            if (!pData)
+                pycpp::Error::ThrowCurrent();
+            writer.String(WireTag::Str, std::string_view(pData, static_cast<size_t>(size)));
+        }
+        else if (PyBytes_Check(pResult))
+            writer.String(WireTag::Bytes, std::string_view(PyBytes_AS_STRING(pResult), static_cast<size_t>(PyBytes_GET_SIZE(pResult))));
+        else if (PyObject_CheckBuffer(pResult))
+        {
+            Py_buffer view{};
+            if (PyObject_GetBuffer(pResult, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0)
+                pycpp::Error::ThrowCurrent();
+            writer.Buffer(view.format ? view.format : "B", static_cast<size_t>(view.itemsize), view.buf, static_cast<size_t>(view.len));
+            PyBuffer_Release(&view);
+        }
+        else
+            throw pycpp::Error(std::string("ProcessPool: results of type ") + Py_TYPE(pResult)->tp_name + " can not be sent back");
+    }
+
+    std::vector<std::byte> HandleRequest(pycpp::detail::WireReader& reader, std::unordered_map<std::string, pycpp::Object>& functions)
+    {
+        std::vector<std::byte> response;
+        pycpp::detail::WireWriter writer(response);
+        try
+        {
+            if (reader.Tag() != pycpp::detail::WireTag::Str)
+                throw pycpp::Error("ProcessPool: invalid call");
+            const std::string path(reader.String());
+            auto it = functions.find(path);
+            if (it == functions.end())
+                it = functions.emplace(path, ResolveFunction(path)).first;
+
+            const auto count = reader.Raw<uint32_t>();
+            std::vector<pycpp::Object> arguments;
+            arguments.reserve(count);
+            for (uint32_t idx = 0; idx < count; ++idx)
+                arguments.push_back(ReadArgument(reader));
+
+            std::vector<PyObject*> argumentArray;
+            argumentArray.reserve(count);
+            for (const auto& argument : arguments)
+                argumentArray.push_back(argument.get());
+            pycpp::Object result = pycpp::VectorcallObject(it->second.get(), argumentArray.data(), argumentArray.size());
+            WriteResult(writer, result.get());
+        }
+        catch (const std::exception& e)
+        {
+            PyErr_Clear();
+            response.clear();
+            writer.String(pycpp::detail::WireTag::Error, e.what());
+        }
+        return response;
+    }
+}
+
+struct pycpp::detail::ProcessWorker
+{
+    explicit ProcessWorker(size_t ringCapacity)
+        : requests(ringCapacity), responses(ringCapacity)
+    {}
+
+    pid_t pid = -1;
+    SharedRing requests;
+    SharedRing responses;
+    // held while writing requests, so the completions are in the order of the requests
+    std::mutex writeMutex;
+    std::mutex completionsMutex;
+    std::deque<std::function<void(WireReader*, std::exception_ptr)>> completions;
+    std::atomic<size_t> pending{ 0 };
+    std::atomic<bool> exited{ false };
+    std::thread reader;
+
+    [[noreturn]] void RunChild(pid_t parent) noexcept;
+    void ReadResponses() noexcept;
+    void FailRemaining() noexcept;
+};
+
+void pycpp::detail::ProcessWorker::RunChild(pid_t parent) noexcept
+{
+#ifdef __linux__
+    // do not outlive the pool if the parent crashes. The signal is sent when the thread that forked
+    // exits (see ProcessPool), and not at all if the parent is already gone by now
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+    if (getppid() != parent)
+        _exit(1);
+#endif
+    std::unordered_map<std::string, Object> functions;
+    std::vector<std::byte> request;
+    try
+    {
+        while (true)
+        {
+            {
+                GILRelease release;
+                requests.Read(request);
+            }
+            WireReader reader(request);
+            // an empty message asks the worker to exit, it confirms with an empty response
+            if (reader.AtEnd())
+                break;
+            auto response = HandleRequest(reader, functions);
+            if (response.size() > responses.MaxMessageSize())
+            {
+                const auto size = response.size();
+                response.clear();
+                WireWriter writer(response);
+                writer.String(WireTag::Error, "ProcessPool: result of " + std::to_string(size) + " bytes does not fit into the ring");
+            }
+            responses.Write(response, [] { return false; });
+        }
+        responses.Write({}, [] { return false; });
+    }
+    catch (...)
+    {
+        _exit(1);
+    }
+    // skips atexit handlers and destructors of the state copied from the parent
+    _exit(0);
+}
+
+void pycpp::detail::ProcessWorker::ReadResponses() noexcept
+{
+    std::vector<std::byte> response;
+    bool reaped = false;
+    while (true)
+    {
+        if (reaped)
+        {
+            // collect what the worker sent before it exited
+            if (!responses.TryRead(response))
+                break;
+        }
+        else if (!responses.Read(response, std::chrono::milliseconds(100)))
+        {
+            // nothing within the timeout, check whether the worker crashed or was killed
+            reaped = waitpid(pid, nullptr, WNOHANG) == pid;
+            continue;
+        }
+
+        if (response.empty())
+        {
+            if (!reaped)
+                waitpid(pid, nullptr, 0);
+            break;
+        }
+
+        std::function<void(WireReader*, std::exception_ptr)> completion;
+        {
+            std::lock_guard<std::mutex> lock(completionsMutex);
+            if (completions.empty())
+                continue;
+            completion = std::move(completions.front());
+            completions.pop_front();
+        }
+        WireReader reader(response);
+        completion(&reader, nullptr);
+        --pending;
+    }
+    FailRemaining();
+}
+
+void pycpp::detail::ProcessWorker::FailRemaining() noexcept
+{
+    std::deque<std::function<void(WireReader*, std::exception_ptr)>> remaining;
+    {
+        std::lock_guard<std::mutex> lock(completionsMutex);
+        exited = true;
+        remaining.swap(completions);
+    }
+    for (auto& completion : remaining)
+    {
+        completion(nullptr, std::make_exception_ptr(Error("ProcessPool: worker process exited")));
+        --pending;
+    }
+}
+
+const std::byte* pycpp::detail::WireReader::Bytes(size_t size)
+{
+    if (m_data.size() - m_offset < size)
+        throw Error("ProcessPool: truncated message");
+    const auto* pData = m_data.data() + m_offset;
+    m_offset += size;
+    return pData;
+}
+
+std::string_view pycpp::detail::WireReader::String()
+{
+    const auto size = Raw<uint64_t>();
+    const auto* pData = Bytes(size);
+    return std::string_view(reinterpret_cast<const char*>(pData), size);
+}
+
+pycpp::detail::WireReader::BufferData pycpp::detail::WireReader::Buffer()
+{
+    BufferData buffer;
+    const auto formatSize = Raw<uint32_t>();
+    buffer.format = std::string_view(reinterpret_cast<const char*>(Bytes(formatSize)), formatSize);
+    buffer.itemSize = Raw<uint64_t>();
+    buffer.size = Raw<uint64_t>();
+    buffer.pData = Bytes(buffer.size);
+    return buffer;
+}
+
+void pycpp::detail::ThrowIfError(WireTag tag, WireReader& reader)
+{
+    if (tag == WireTag::Error)
+        throw Error(std::string(reader.String()));
+}
+
+pycpp::ProcessPool::ProcessPool(size_t size, size_t ringCapacity)
+{
+    if (size == 0)
+        throw Error("ProcessPool: size must not be zero");
+
+    GILAcquire gil;
+    const auto parent = getpid();
+    m_workers.reserve(size);
+    try
+    {
+        for (size_t idx = 0; idx < size; ++idx)
+        {
+            auto& worker = *m_workers.emplace_back(std::make_unique<detail::ProcessWorker>(ringCapacity));
+            PyOS_BeforeFork();
+            worker.pid = fork();
+            if (worker.pid == 0)
+            {
+                PyOS_AfterFork_Child();
+                worker.RunChild(parent);
+            }
+            PyOS_AfterFork_Parent();
+            if (worker.pid < 0)
+            {
+                m_workers.pop_back();
+                throw Error("ProcessPool: fork failed: " + std::string(strerror(errno)));
+            }
+        }
+    }
+    catch (...)
+    {
+        for (auto& pWorker : m_workers)
+        {
+            kill(pWorker->pid, SIGKILL);
+            waitpid(pWorker->pid, nullptr, 0);
+        }
+        m_workers.clear();
+        throw;
+    }
+
+    // threads are only started once all workers are forked, fork does not copy them
+    for (auto& pWorker : m_workers)
+        pWorker->reader = std::thread([pWorker = pWorker.get()] { pWorker->ReadResponses(); });
+}
+
+pycpp::ProcessPool::~ProcessPool()
+{
+    for (auto& pWorker : m_workers)
+    {
+        std::lock_guard<std::mutex> lock(pWorker->writeMutex);
+        pWorker->requests.Write({}, [pWorker = pWorker.get()] { return pWorker->exited.load(); });
+    }
+    for (auto& pWorker : m_workers)
+        pWorker->reader.join();
+}
+
+void pycpp::ProcessPool::Post(const std::vector<std::byte>& message, Completion completion)
+{
+    auto* pWorker = m_workers.front().get();
+    for (auto& pCandidate : m_workers)
+    {
+        if (pCandidate->pending < pWorker->pending)
+            pWorker = pCandidate.get();
+    }
+    if (message.size() > pWorker->requests.MaxMessageSize())
+        throw Error("ProcessPool: call of " + std::to_string(message.size()) + " bytes does not fit into the ring");
+
+    std::lock_guard<std::mutex> lock(pWorker->writeMutex);
+    {
+        std::lock_guard<std::mutex> completionsLock(pWorker->completionsMutex);
+        if (pWorker->exited)
+            throw Error("ProcessPool: worker process exited");
+        pWorker->completions.push_back(std::move(completion));
+        ++pWorker->pending;
+    }
+    // if the worker exits while the ring is full, the completion fails with the others
+    pWorker->requests.Write(message, [pWorker] { return pWorker->exited.load(); });
+}
+
+#endif // _WIN32
@@ -0,0 +1,23 @@
+#include "Record.h"
+
+pycpp::detail::RecordDescription::RecordDescription(const char* pName, std::span<const char* const> fieldNames)
+    : m_name(std::string("pycpp.") + pName)
+{
+    m_fields.reserve(fieldNames.size() + 1);
+    for (const auto pFieldName : fieldNames)
+        m_fields.push_back(PyStructSequence_Field{ pFieldName, nullptr });
+    m_fields.push_back(PyStructSequence_Field{ nullptr, nullptr });
+
+    m_desc.name = m_name.c_str();
+    m_desc.doc = nullptr;
+    m_desc.fields = m_fields.data();
+    m_desc.n_in_sequence = static_cast<int>(fieldNames.size());
+}
+
+pycpp::Object pycpp::detail::RecordDescription::NewType()
+{
+    Object type = reinterpret_cast<PyObject*>(PyStructSequence_NewType(&m_desc));
+    if (!type)
+        Error::ThrowCurrent();
+    return type;
+}
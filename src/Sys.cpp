@@ -4,26 +4,26 @@ void pycpp::Sys::AddToPath(const std::string& path)
 {
     auto* py_path_list = PySys_GetObject("path");
     if (!py_path_list)
-        throw Error();
+        Error::ThrowCurrent();
 
     pycpp::Object py_path_string = PyUnicode_FromString(path.c_str());
     if (!py_path_string)
-        throw Error();
+        Error::ThrowCurrent();
 
     if (PyList_Append(py_path_list, py_path_string.get()) != 0)
-        throw Error();
+        Error::ThrowCurrent();
 }
 
 void pycpp::Sys::AddToPath(const char* path)
 {
     auto* py_path_list = PySys_GetObject("path");
     if (!py_path_list)
-        throw Error();
+        Error::ThrowCurrent();
 
     pycpp::Object py_path_string = PyUnicode_FromString(path);
     if (!py_path_string)
-        throw Error();
+        Error::ThrowCurrent();
 
     if (PyList_Append(py_path_list, py_path_string.get()) != 0)
-        throw Error();
+        Error::ThrowCurrent();
 }
@@ -3,10 +3,7 @@
 
 pycpp::Object pycpp::ImportModule(const char* module_name)
 {
-    Object retVal = PyImport_ImportModule(module_name);
-    if (!retVal)
-        throw Error();
-    return retVal;
+    return TryImportModule(module_name).value();
 }
 
 pycpp::Object pycpp::ImportModule(const std::string& module_name)
@@ -14,11 +11,27 @@ pycpp::Object pycpp::ImportModule(const std::string& module_name)
     return ImportModule(module_name.c_str());
 }
 
+pycpp::Result<pycpp::Object> pycpp::TryImportModule(const char* module_name)
+{
+    Object module = PyImport_ImportModule(module_name);
+    if (!module)
+        return ErrorInfo::Fetch();
+    return module;
+}
+
+pycpp::Result<pycpp::Object> pycpp::TryImportModule(const std::string& module_name)
+{
+    return TryImportModule(module_name.c_str());
+}
+
 pycpp::Object pycpp::GetAttributeString(PyObject* pObject, const char* attr_name)
 {
-    Object retVal = PyObject_GetAttrString(pObject, attr_name);
+    const auto name = detail::NameObject(attr_name);
+    if (!name)
+        Error::ThrowCurrent();
+    Object retVal = PyObject_GetAttr(pObject, name.get());
     if (!retVal)
-        throw Error();
+        Error::ThrowCurrent();
     return retVal;
 }
 
@@ -29,10 +42,29 @@ pycpp::Object pycpp::GetAttributeString(const Object& pObject, const char* attr_
 
 pycpp::Object pycpp::GetAttributeString(PyObject* pObject, const std::string& attr_name)
 {
-    return GetAttributeString(pObject, attr_name.c_str());
+    const auto name = detail::NameObject(attr_name);
+    if (!name)
+        Error::ThrowCurrent();
+    Object retVal = PyObject_GetAttr(pObject, name.get());
+    if (!retVal)
+        Error::ThrowCurrent();
+    return retVal;
 }
 
 pycpp::Object pycpp::GetAttributeString(const Object& pObject, const std::string& attr_name)
 {
-    return GetAttributeString(pObject.get(), attr_name.c_str());
+    return GetAttributeString(pObject.get(), attr_name);
+}
+
+pycpp::Object pycpp::GetAttributeString(PyObject* pObject, const AttributeName& attr_name)
+{
+    Object retVal = PyObject_GetAttr(pObject, attr_name.Get());
+    if (!retVal)
+        Error::ThrowCurrent();
+    return retVal;
+}
+
+pycpp::Object pycpp::GetAttributeString(const Object& pObject, const AttributeName& attr_name)
+{
+    return GetAttributeString(pObject.get(), attr_name);
 }
@@ -0,0 +1,110 @@
+#include "PythonCpp.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <memory>
+
+namespace
+{
+    struct DetachedTask
+    {
+        struct promise_type
+        {
+            DetachedTask get_return_object() noexcept { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { std::terminate(); }
+        };
+    };
+
+    // the promise is shared, the coroutine may still be running on the loop thread when the result was received
+    DetachedTask AddAsync(const pycpp::EventLoop& loop, const pycpp::Callable& add, long lhs, long rhs, std::shared_ptr<std::promise<long>> pResult)
+    {
+        try
+        {
+            const auto sum = co_await loop.Call<long>(add, lhs, rhs);
+            // resumed on the loop thread, await again from there
+            pResult->set_value(sum + co_await loop.Call<long>(add, 0L, 0L));
+        }
+        catch (...)
+        {
+            pResult->set_exception(std::current_exception());
+        }
+    }
+
+    pycpp::Object DefineAsyncFunctions()
+    {
+        pycpp::Object globals = PyDict_New();
+        PyDict_SetItemString(globals.get(), "__builtins__", PyEval_GetBuiltins());
+        pycpp::Object result = PyRun_String(
+            "import asyncio\n"
+            "async def add(a, b):\n"
+            "    await asyncio.sleep(0.05)\n"
+            "    if a < 0:\n"
+            "        raise ValueError('negative')\n"
+            "    return a + b\n",
+            Py_file_input, globals.get(), globals.get());
+        if (!result)
+            throw pycpp::Error();
+        return globals;
+    }
+
+    // asyncio does not survive finalizing and reinitializing Python on every version (3.12.1
+    // crashes), so all tests of this suite share one interpreter
+    class AsyncTests : public ::testing::Test
+    {
+    protected:
+        static void SetUpTestSuite()
+        {
+            s_pHandle = new pycpp::InterpreterHandle(pycpp::Interpreter::Handle());
+        }
+
+        static void TearDownTestSuite()
+        {
+            delete s_pHandle;
+            s_pHandle = nullptr;
+        }
+
+        static pycpp::InterpreterHandle* s_pHandle;
+    };
+
+    pycpp::InterpreterHandle* AsyncTests::s_pHandle = nullptr;
+}
+
+TEST_F(AsyncTests, ConcurrentCoroutines)
+{
+    pycpp::EventLoop loop;
+    pycpp::Callable add = pycpp::Object::BorrowedRef(PyDict_GetItemString(DefineAsyncFunctions().get(), "add"));
+
+    constexpr long count = 200;
+    std::vector<std::future<long>> results;
+    const auto start = std::chrono::steady_clock::now();
+    for (long idx = 0; idx < count; ++idx)
+    {
+        auto pResult = std::make_shared<std::promise<long>>();
+        results.push_back(pResult->get_future());
+        AddAsync(loop, add, idx, 1, std::move(pResult));
+    }
+
+    pycpp::GILRelease release;
+    long total = 0;
+    for (auto& result : results)
+        total += result.get();
+    EXPECT_EQ(total, count * (count - 1) / 2 + count);
+    // all calls sleep at the same time
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+TEST_F(AsyncTests, ExceptionsAreRethrown)
+{
+    pycpp::EventLoop loop;
+    pycpp::Callable add = pycpp::Object::BorrowedRef(PyDict_GetItemString(DefineAsyncFunctions().get(), "add"));
+
+    auto pResult = std::make_shared<std::promise<long>>();
+    auto result = pResult->get_future();
+    AddAsync(loop, add, -1, 1, std::move(pResult));
+
+    pycpp::GILRelease release;
+    EXPECT_THROW(result.get(), pycpp::Error);
+}
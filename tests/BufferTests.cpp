@@ -0,0 +1,160 @@
+#include "PythonCpp.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+TEST(BufferTests, VectorExport)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    const std::vector<double> values{ 1.0, 2.5, -3.0 };
+    const pycpp::Buffer buffer(values);
+    auto memoryView = buffer.MemoryView();
+
+    EXPECT_EQ(pycpp::python_cast<std::string>(memoryView.GetAttribute("format")), "d");
+    EXPECT_TRUE(pycpp::python_cast<bool>(memoryView.GetAttribute("readonly")));
+
+    pycpp::List<double> list = pycpp::CallFunction(memoryView, "tolist");
+    EXPECT_EQ(list.ToVector(), values);
+
+    // no copy was made
+    Py_buffer view;
+    ASSERT_EQ(PyObject_GetBuffer(buffer.get(), &view, PyBUF_SIMPLE), 0);
+    EXPECT_EQ(view.buf, static_cast<const void*>(values.data()));
+    PyBuffer_Release(&view);
+
+    // Python can't create exporters without memory behind them
+    const pycpp::Callable exporterType = pycpp::Object::BorrowedRef(reinterpret_cast<PyObject*>(Py_TYPE(buffer.get())));
+    EXPECT_THROW(exporterType(), pycpp::TypeError);
+}
+
+TEST(BufferTests, MatrixExport)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    const std::vector<int> matrix{ 1, 2, 3, 4, 5, 6 };
+    const pycpp::Buffer buffer(matrix.data(), { 2, 3 });
+    auto memoryView = buffer.MemoryView();
+
+    pycpp::Tuple<long, long> shape = memoryView.GetAttribute("shape");
+    EXPECT_EQ(shape.ToStdTuple(), std::make_tuple(2L, 3L));
+
+    pycpp::Tuple<long, long> strides = memoryView.GetAttribute("strides");
+    EXPECT_EQ(strides.ToStdTuple(), std::make_tuple(static_cast<long>(3 * sizeof(int)), static_cast<long>(sizeof(int))));
+
+    const pycpp::List<pycpp::List<long>> rows = pycpp::CallFunction(memoryView, "tolist");
+    pycpp::List<long> row = rows[1];
+    EXPECT_EQ(row.ToVector(), (std::vector<long>{ 4, 5, 6 }));
+}
+
+TEST(BufferTests, ContiguityIsChecked)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    // the transpose of a row-major 2x3 matrix is Fortran-contiguous
+    const std::vector<int> matrix{ 1, 2, 3, 4, 5, 6 };
+    const pycpp::Buffer transposed(matrix.data(), { 3, 2 }, { sizeof(int), 3 * sizeof(int) });
+    EXPECT_THROW(pycpp::BufferView<int>{ transposed }, pycpp::Error);
+
+    const auto getBuffer = [](const pycpp::Object& obj, int flags)
+        {
+            Py_buffer view;
+            if (PyObject_GetBuffer(obj.get(), &view, flags) != 0)
+            {
+                PyErr_Clear();
+                return false;
+            }
+            PyBuffer_Release(&view);
+            return true;
+        };
+    EXPECT_FALSE(getBuffer(transposed, PyBUF_C_CONTIGUOUS));
+    EXPECT_TRUE(getBuffer(transposed, PyBUF_F_CONTIGUOUS));
+    EXPECT_TRUE(getBuffer(transposed, PyBUF_ANY_CONTIGUOUS));
+    EXPECT_TRUE(getBuffer(transposed, PyBUF_FULL_RO));
+
+    // every other item is neither
+    const pycpp::Buffer strided(matrix.data(), { 3 }, { 2 * sizeof(int) });
+    EXPECT_FALSE(getBuffer(strided, PyBUF_ANY_CONTIGUOUS));
+    EXPECT_FALSE(getBuffer(strided, PyBUF_F_CONTIGUOUS));
+    EXPECT_TRUE(getBuffer(strided, PyBUF_STRIDED_RO));
+
+    const pycpp::List<pycpp::List<long>> rows = pycpp::CallFunction(transposed.MemoryView(), "tolist");
+    pycpp::List<long> row = rows[0];
+    EXPECT_EQ(row.ToVector(), (std::vector<long>{ 1, 4 }));
+}
+
+TEST(BufferTests, OwnedVectorIsWritable)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    pycpp::Buffer buffer(std::vector<long long>{ 1, 2, 3 });
+    auto memoryView = buffer.MemoryView();
+    EXPECT_FALSE(pycpp::python_cast<bool>(memoryView.GetAttribute("readonly")));
+
+    // the vector is kept alive by the exporter even after the Buffer is gone
+    buffer = pycpp::Buffer(std::vector<long long>{});
+    pycpp::List<long long> list = pycpp::CallFunction(memoryView, "tolist");
+    EXPECT_EQ(list.ToVector(), (std::vector<long long>{ 1, 2, 3 }));
+}
+
+TEST(BufferTests, BufferViewImport)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    auto array = pycpp::ImportModule("array");
+    pycpp::Callable arrayFn = array.GetAttribute("array");
+    const auto pyArray = arrayFn("d", pycpp::List<double>({ 0.5, 1.5, 2.5 }));
+
+    const auto view = pycpp::python_cast<pycpp::BufferView<double>>(pyArray);
+    EXPECT_EQ(std::vector<double>(view.begin(), view.end()), (std::vector<double>{ 0.5, 1.5, 2.5 }));
+    EXPECT_EQ(view.ndim(), 1u);
+    EXPECT_EQ(view.shape()[0], 3);
+
+    const auto bytes = pycpp::python_cast<pycpp::BufferView<std::byte>>(pycpp::CallFunction(pycpp::ToObject("abc"), "encode"));
+    ASSERT_EQ(bytes.size(), 3u);
+    EXPECT_EQ(bytes[1], std::byte{ 'b' });
+
+    EXPECT_THROW(pycpp::BufferView<int>{ pyArray }, pycpp::Error);
+    EXPECT_THROW(pycpp::BufferView<double>{ pycpp::ToObject(1.0) }, pycpp::Error);
+}
+
+TEST(BufferTests, BufferViewReleasesOnErrorAndMoves)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    // a view rejected for its format must not keep the bytearray exported
+    pycpp::Object byteArray = PyByteArray_FromStringAndSize("abcdefgh", 8);
+    ASSERT_TRUE(byteArray);
+    EXPECT_THROW(pycpp::BufferView<double>{ byteArray }, pycpp::Error);
+    EXPECT_EQ(PyByteArray_Resize(byteArray.get(), 4), 0);
+
+    // bytearray points shape and strides into the Py_buffer, they have to survive the move
+    auto pSource = std::make_unique<pycpp::BufferView<std::byte>>(byteArray);
+    pycpp::BufferView<std::byte> moved(std::move(*pSource));
+    pSource.reset();
+    EXPECT_EQ(moved.shape()[0], 4);
+    EXPECT_EQ(moved.strides()[0], 1);
+
+    pycpp::BufferView<std::byte> assigned(byteArray);
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.shape()[0], 4);
+    assigned.Release();
+    EXPECT_EQ(PyByteArray_Resize(byteArray.get(), 2), 0);
+}
+
+TEST(BufferTests, BufferViewRoundTrip)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    const std::vector<float> matrix{ 1.f, 2.f, 3.f, 4.f, 5.f, 6.f };
+    const pycpp::Buffer buffer(matrix.data(), { 3, 2 });
+
+    pycpp::BufferView<float> view(buffer);
+    EXPECT_EQ(view.data(), matrix.data());
+    EXPECT_EQ(view.ndim(), 2u);
+    EXPECT_EQ(view.shape()[0], 3);
+    EXPECT_EQ(view.strides()[0], static_cast<Py_ssize_t>(2 * sizeof(float)));
+
+    const auto refCnt = Py_REFCNT(buffer.get());
+    view.Release();
+    EXPECT_EQ(Py_REFCNT(buffer.get()), refCnt - 1);
+}
@@ -0,0 +1,250 @@
+#include "PythonCpp.h"
+#include <gtest/gtest.h>
+#include <exception>
+#include <string>
+#include <thread>
+
+TEST(CallableTests, PositionalArguments)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    auto builtins = pycpp::ImportModule("builtins");
+    pycpp::Callable maxFn = builtins.GetAttribute("max");
+
+    EXPECT_EQ(pycpp::python_cast<long>(maxFn(1L, 7, 3LL)), 7);
+    EXPECT_EQ(pycpp::python_cast<double>(maxFn(1.5, 0.5)), 1.5);
+    EXPECT_EQ(pycpp::python_cast<std::string>(maxFn("a", std::string("b"))), "b");
+}
+
+TEST(CallableTests, ObjectArgumentsAreBorrowed)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    auto builtins = pycpp::ImportModule("builtins");
+    pycpp::Callable lenFn = builtins.GetAttribute("len");
+
+    pycpp::List<long> list({ 1, 2, 3 });
+    const auto refCnt = Py_REFCNT(list.get());
+
+    EXPECT_EQ(pycpp::python_cast<long>(lenFn(list)), 3);
+    EXPECT_EQ(Py_REFCNT(list.get()), refCnt);
+}
+
+TEST(CallableTests, NoArguments)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    auto builtins = pycpp::ImportModule("builtins");
+    pycpp::Callable listFn = builtins.GetAttribute("list");
+
+    const pycpp::List<long> result = listFn();
+    EXPECT_EQ(result.size(), 0u);
+}
+
+TEST(CallableTests, ErrorIsThrown)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    auto builtins = pycpp::ImportModule("builtins");
+    pycpp::Callable intFn = builtins.GetAttribute("int");
+
+    EXPECT_THROW(intFn("not a number"), pycpp::Error);
+}
+
+TEST(CallableTests, ErrorsAreTyped)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    auto builtins = pycpp::ImportModule("builtins");
+    pycpp::Callable intFn = builtins.GetAttribute("int");
+    EXPECT_THROW(intFn("not a number"), pycpp::ValueError);
+    EXPECT_THROW(intFn(pycpp::List<long>({ 1 })), pycpp::TypeError);
+    EXPECT_THROW(builtins.GetAttribute("no_such_attribute"), pycpp::AttributeError);
+    EXPECT_THROW(pycpp::ImportModule("no_such_module"), pycpp::ImportError);
+
+    const pycpp::Callable getItem = pycpp::ImportModule("operator").GetAttribute("getitem");
+    try
+    {
+        getItem(pycpp::Object(PyDict_New()), "key");
+        FAIL();
+    }
+    catch (const pycpp::KeyError& e)
+    {
+        EXPECT_TRUE(e.Matches(PyExc_LookupError));
+        EXPECT_EQ(e.Type().get(), PyExc_KeyError);
+        EXPECT_STREQ(e.what(), "KeyError('key')");
+
+        // back to Python, and out again
+        e.Restore();
+        EXPECT_TRUE(PyErr_ExceptionMatches(PyExc_KeyError));
+        EXPECT_THROW(pycpp::Error::ThrowCurrent(), pycpp::KeyError);
+    }
+
+    // detached errors keep their message without the Python objects
+    try
+    {
+        intFn("not a number");
+        FAIL();
+    }
+    catch (const pycpp::Error& e)
+    {
+        e.Detach();
+        EXPECT_FALSE(e.Type());
+        EXPECT_NE(std::string(e.what()).find("not a number"), std::string::npos);
+    }
+}
+
+TEST(CallableTests, TryInvoke)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    auto builtins = pycpp::ImportModule("builtins");
+    pycpp::Callable intFn = builtins.GetAttribute("int");
+
+    auto result = intFn.TryInvoke("12");
+    ASSERT_TRUE(result);
+    EXPECT_EQ(pycpp::python_cast<long>(*result), 12);
+
+    auto failed = intFn.TryInvoke("not a number");
+    ASSERT_FALSE(failed);
+    EXPECT_TRUE(failed.error().Matches(PyExc_ValueError));
+    EXPECT_FALSE(PyErr_Occurred());
+
+    EXPECT_TRUE(builtins.TryGetAttribute("len"));
+    EXPECT_TRUE(builtins.TryGetAttribute("no_such_attribute").error().Matches(PyExc_AttributeError));
+    EXPECT_TRUE(pycpp::TryImportModule("no_such_module").error().Matches(PyExc_ModuleNotFoundError));
+
+    // the error can be handed back to Python
+    failed.error().Restore();
+    EXPECT_TRUE(PyErr_ExceptionMatches(PyExc_ValueError));
+    PyErr_Clear();
+}
+
+TEST(CallableTests, ErrorsAreFormattedOnOtherThreads)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    std::exception_ptr exception;
+    try
+    {
+        pycpp::ImportModule("operator").GetAttribute("no_such_attribute");
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    // formatting and releasing the error acquire the GIL
+    std::string message;
+    pycpp::GILRelease release;
+    std::thread([&message, exception = std::move(exception)]() mutable
+        {
+            try
+            {
+                std::rethrow_exception(exception);
+            }
+            catch (const pycpp::Error& e)
+            {
+                message = e.what();
+            }
+            exception = nullptr;
+        }).join();
+    EXPECT_NE(message.find("no_such_attribute"), std::string::npos);
+}
+
+TEST(CallableTests, KeywordArguments)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    auto builtins = pycpp::ImportModule("builtins");
+    pycpp::Callable intFn = builtins.GetAttribute("int");
+
+    static const pycpp::Keywords baseKw("base");
+    EXPECT_EQ(pycpp::python_cast<long>(intFn("ff", baseKw(16))), 255);
+    EXPECT_EQ(pycpp::python_cast<long>(intFn("11", baseKw(2))), 3);
+
+    pycpp::Callable sortedFn = builtins.GetAttribute("sorted");
+    static const pycpp::Keywords sortKw("key", "reverse");
+    pycpp::List<long> list({ 3, -5, 1 });
+    pycpp::List<long> sorted = sortedFn(list, sortKw(builtins.GetAttribute("abs"), true));
+    EXPECT_EQ(sorted.ToVector(), (std::vector<long>{ -5, 3, 1 }));
+}
+
+TEST(CallableTests, KeywordNamesSurviveReinitialization)
+{
+    static const pycpp::Keywords baseKw("base");
+    for (int run = 0; run < 2; ++run)
+    {
+        auto handle = pycpp::Interpreter::Handle();
+
+        pycpp::Callable intFn = pycpp::ImportModule("builtins").GetAttribute("int");
+        EXPECT_EQ(pycpp::python_cast<long>(intFn("10", baseKw(8))), 8);
+    }
+}
+
+TEST(CallableTests, MethodHandle)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    static const pycpp::MethodHandle upper("upper");
+    static const pycpp::MethodHandle split("split");
+    static const pycpp::Keywords maxsplitKw("maxsplit");
+
+    const auto str = pycpp::ToObject("a b c");
+    EXPECT_EQ(pycpp::python_cast<std::string>(upper(str)), "A B C");
+
+    const pycpp::List<std::string> parts = split(str, " ", maxsplitKw(1));
+    EXPECT_EQ(parts.size(), 2u);
+    EXPECT_EQ(pycpp::python_cast<std::string>(pycpp::CallFunction(str, "replace", " ", "")), "abc");
+
+    EXPECT_THROW(upper(pycpp::ToObject(1L)), pycpp::Error);
+}
+
+TEST(CallableTests, AttributeNames)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    const auto builtins = pycpp::ImportModule("builtins");
+    static const pycpp::AttributeName lenName("len");
+
+    EXPECT_TRUE(builtins.HasAttribute("len"));
+    EXPECT_TRUE(builtins.HasAttribute(lenName));
+    EXPECT_FALSE(builtins.HasAttribute("no_such_attribute"));
+    EXPECT_EQ(builtins.GetAttribute("len").get(), builtins.GetAttribute(lenName).get());
+    EXPECT_EQ(builtins.GetAttribute(PYCPP_NAME("len")).get(), builtins.GetAttribute(std::string("len")).get());
+    EXPECT_EQ(pycpp::detail::InternName("len"), lenName.Get());
+    EXPECT_THROW(builtins.GetAttribute("no_such_attribute"), pycpp::Error);
+
+    // names built at runtime are not cached
+    const auto& cached = pycpp::detail::CurrentInterpreterState().internedNames;
+    const auto cachedCount = cached.size();
+    for (int idx = 0; idx < 100; ++idx)
+        EXPECT_FALSE(builtins.HasAttribute("dynamic_" + std::to_string(idx)));
+    EXPECT_THROW(builtins.GetAttribute(std::string("dynamic_name")), pycpp::AttributeError);
+    const std::string methodName = std::string("up") + "per";
+    EXPECT_EQ(pycpp::python_cast<std::string>(pycpp::CallFunction(pycpp::ToObject("abc"), methodName.c_str())), "ABC");
+    EXPECT_EQ(cached.size(), cachedCount);
+}
+
+TEST(CallableTests, Map)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    const pycpp::Callable sqrt = pycpp::ImportModule("math").GetAttribute("sqrt");
+    const std::vector<double> squares{ 1.0, 4.0, 9.0 };
+    EXPECT_EQ(sqrt.Map<double>(squares), (std::vector<double>{ 1.0, 2.0, 3.0 }));
+    EXPECT_THROW(sqrt.Map<double>(std::vector<double>{ 1.0, -1.0 }), pycpp::Error);
+
+    const auto builtins = pycpp::ImportModule("builtins");
+    const pycpp::Callable abs = builtins.GetAttribute("abs");
+    std::vector<long> out{ 42 };
+    abs.MapInto(std::vector<int>{ -1, 2, -3 }, out);
+    EXPECT_EQ(out, (std::vector<long>{ 1, 2, 3 }));
+    EXPECT_TRUE(abs.Map<long>(std::vector<int>{}).empty());
+
+    // the whole batch is passed as one list, any sequence of the same length is accepted
+    const pycpp::Callable reversed = builtins.GetAttribute("reversed");
+    EXPECT_EQ(reversed.Map<long>(std::vector<int>{ 1, 2, 3 }, pycpp::MapMode::Batch), (std::vector<long>{ 3, 2, 1 }));
+    const pycpp::Callable set = builtins.GetAttribute("set");
+    EXPECT_THROW(set.Map<long>(std::vector<int>{ 1, 1 }, pycpp::MapMode::Batch), pycpp::Error);
+}
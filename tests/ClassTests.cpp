@@ -0,0 +1,164 @@
+#include "PythonCpp.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+    class FeatureStore
+    {
+    public:
+        explicit FeatureStore(long fallback)
+            : m_fallback(fallback)
+        {}
+
+        long Lookup(const std::string& key)
+        {
+            ++hits;
+            const auto it = m_features.find(key);
+            return it != m_features.end() ? it->second : m_fallback;
+        }
+
+        void Insert(std::string key, long value)
+        {
+            m_features[std::move(key)] = value;
+        }
+
+        size_t Size() const noexcept
+        {
+            return m_features.size();
+        }
+
+        long Fallback() const noexcept
+        {
+            return m_fallback;
+        }
+
+        void SetFallback(long fallback)
+        {
+            if (fallback < 0)
+                throw std::invalid_argument("fallback must not be negative");
+            m_fallback = fallback;
+        }
+
+        long hits = 0;
+        const std::string name = "features";
+
+    private:
+        std::map<std::string, long> m_features;
+        long m_fallback;
+    };
+
+    long Total(const FeatureStore& store, long extra)
+    {
+        return static_cast<long>(store.Size()) + extra;
+    }
+
+    struct Counter
+    {
+        static inline int s_alive = 0;
+
+        Counter() noexcept { ++s_alive; }
+        Counter(const Counter&) noexcept { ++s_alive; }
+        ~Counter() { --s_alive; }
+    };
+
+    struct Marker
+    {};
+}
+
+TEST(ClassTests, MethodsAndProperties)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    pycpp::Class<FeatureStore>("features.FeatureStore", "C++ feature store")
+        .Constructor<long>()
+        .Method<&FeatureStore::Lookup>("lookup")
+        .Method<&FeatureStore::Insert>("insert")
+        .Method<&Total>("total")
+        .Property<&FeatureStore::Size>("size")
+        .Property<&FeatureStore::Fallback, &FeatureStore::SetFallback>("fallback")
+        .Property<&FeatureStore::hits>("hits")
+        .Property<&FeatureStore::name>("name");
+
+    pycpp::Object globals = PyDict_New();
+    PyDict_SetItemString(globals.get(), "__builtins__", PyEval_GetBuiltins());
+    PyDict_SetItemString(globals.get(), "FeatureStore", pycpp::Class<FeatureStore>::Type().get());
+    pycpp::Object result = PyRun_String(
+        "store = FeatureStore(-1)\n"
+        "store.insert('price', 10)\n"
+        "store.insert('volume', 20)\n"
+        "found = (store.lookup('price'), store.lookup('missing'), store.size, store.total(5))\n"
+        "store.hits = 100\n"
+        "store.fallback = 3\n"
+        "errors = []\n"
+        "for fn in (lambda: store.lookup(), lambda: store.lookup(1), lambda: setattr(store, 'size', 1),\n"
+        "           lambda: setattr(store, 'name', 'x'), lambda: setattr(store, 'fallback', -5),\n"
+        "           lambda: FeatureStore(), lambda: FeatureStore(1, x=2)):\n"
+        "    try:\n"
+        "        fn()\n"
+        "    except Exception as e:\n"
+        "        errors.append(type(e).__name__)\n",
+        Py_file_input, globals.get(), globals.get());
+    ASSERT_TRUE(result);
+
+    const pycpp::Dict<std::string, pycpp::Object> objects(globals);
+    EXPECT_EQ((pycpp::Tuple<long, long, long, long>(objects.at("found")).ToStdTuple()), std::make_tuple(10L, -1L, 2L, 7L));
+    EXPECT_EQ(pycpp::List<std::string>(objects.at("errors")).ToVector(),
+        (std::vector<std::string>{ "TypeError", "TypeError", "AttributeError", "AttributeError", "ValueError", "TypeError", "TypeError" }));
+
+    // the Python object works on the C++ object in place
+    const auto store = objects.at("store");
+    ASSERT_TRUE(pycpp::Class<FeatureStore>::Check(store));
+    auto& cppStore = pycpp::Class<FeatureStore>::Get(store);
+    EXPECT_EQ(cppStore.hits, 100);
+    EXPECT_EQ(cppStore.Fallback(), 3);
+    cppStore.Insert("spread", 1);
+    EXPECT_EQ(pycpp::python_cast<long>(store.GetAttribute("size")), 3);
+    EXPECT_EQ(pycpp::python_cast<std::string>(store.GetAttribute("name")), "features");
+    EXPECT_EQ(pycpp::python_cast<std::string>(pycpp::Class<FeatureStore>::Type().GetAttribute("__module__")), "features");
+
+    EXPECT_THROW((void)pycpp::Class<FeatureStore>::Get(pycpp::ToObject(1L)), pycpp::TypeError);
+    EXPECT_THROW(pycpp::Class<FeatureStore>("features.Other"), pycpp::Error);
+}
+
+TEST(ClassTests, InstancesOwnTheirObject)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    pycpp::Class<Counter>("Counter");
+    {
+        const Counter counter;
+        auto instance = pycpp::Class<Counter>::New(counter);
+        EXPECT_EQ(Counter::s_alive, 2);
+
+        // not constructible from Python without a Constructor
+        pycpp::Callable type = pycpp::Class<Counter>::Type();
+        EXPECT_THROW(type(), pycpp::TypeError);
+    }
+    EXPECT_EQ(Counter::s_alive, 0);
+}
+
+TEST(ClassTests, TypesAreCreatedConcurrently)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    pycpp::Class<Marker>("Marker");
+    pycpp::InterpreterPool pool(2);
+    pycpp::GILRelease release;
+
+    // the first use freezes the definition, while the interpreters of the pool create their types
+    auto types = pool.Broadcast([]() { return reinterpret_cast<uintptr_t>(pycpp::Class<Marker>::Type().get()); });
+    // the results are waited for without the GIL, before 3.12 the interpreters share it
+    const auto first = types[0].get();
+    const auto second = types[1].get();
+    pycpp::GILAcquire gil;
+    const auto mainType = reinterpret_cast<uintptr_t>(pycpp::Class<Marker>::Type().get());
+    EXPECT_NE(first, 0u);
+    EXPECT_NE(first, second);
+    EXPECT_NE(first, mainType);
+    EXPECT_TRUE(pycpp::detail::ClassSpecOf<Marker>()->IsInUse());
+}
@@ -0,0 +1,151 @@
+#include "PythonCpp.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace
+{
+    struct Trade
+    {
+        std::string symbol;
+        double price = 0.0;
+        long quantity = 0;
+        bool buy = false;
+    };
+
+    struct TradeColumns
+    {
+        std::vector<double> price;
+        std::vector<long> quantity;
+        std::vector<bool> buy;
+        std::vector<std::string> symbol;
+    };
+}
+
+PYCPP_RECORD(Trade, symbol, price, quantity, buy)
+PYCPP_RECORD(TradeColumns, price, quantity, buy, symbol)
+
+namespace
+{
+    std::string StringAt(const pycpp::Object& column, size_t idx)
+    {
+        const pycpp::Tuple<pycpp::Object, pycpp::Object> parts(column);
+        const auto offsets = pycpp::python_cast<pycpp::BufferView<int64_t>>(parts.at<0>());
+        const auto chars = pycpp::python_cast<pycpp::BufferView<std::byte>>(parts.at<1>());
+        return std::string(reinterpret_cast<const char*>(chars.data()) + offsets[idx], static_cast<size_t>(offsets[idx + 1] - offsets[idx]));
+    }
+}
+
+TEST(ColumnsTests, RowsToColumns)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    std::vector<Trade> trades(1000);
+    for (size_t idx = 0; idx < trades.size(); ++idx)
+        trades[idx] = { idx % 2 ? "ABC" : "", 0.5 * static_cast<double>(idx), static_cast<long>(idx), idx % 3 == 0 };
+
+    const auto columns = pycpp::ToColumns(trades);
+    EXPECT_EQ(columns.size(), 4u);
+
+    const auto prices = pycpp::python_cast<pycpp::BufferView<double>>(columns.at("price"));
+    ASSERT_EQ(prices.size(), trades.size());
+    EXPECT_EQ(prices[999], 499.5);
+    EXPECT_EQ(pycpp::python_cast<pycpp::BufferView<long>>(columns.at("quantity"))[7], 7L);
+    EXPECT_TRUE(pycpp::python_cast<pycpp::BufferView<bool>>(columns.at("buy"))[3]);
+
+    const auto symbols = columns.at("symbol");
+    EXPECT_EQ(StringAt(symbols, 0), "");
+    EXPECT_EQ(StringAt(symbols, 999), "ABC");
+}
+
+TEST(ColumnsTests, SharedColumns)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    TradeColumns trades{ { 1.5, 2.5 }, { 1, 2 }, { true, false }, { "a", "bc" } };
+    const double* pPrices = trades.price.data();
+    auto columns = pycpp::ShareColumns(std::move(trades));
+
+    // the vectors are shared, not copied
+    const auto prices = pycpp::python_cast<pycpp::BufferView<double>>(columns.at("price"));
+    EXPECT_EQ(prices.data(), pPrices);
+    EXPECT_FALSE(pycpp::python_cast<pycpp::BufferView<bool>>(columns.at("buy"))[1]);
+    EXPECT_EQ(StringAt(columns.at("symbol"), 1), "bc");
+
+    // the columns keep the data alive on their own
+    const auto quantity = columns.at("quantity");
+    columns = pycpp::Dict<std::string, pycpp::Object>();
+    EXPECT_EQ(pycpp::python_cast<pycpp::BufferView<long>>(quantity)[1], 2L);
+
+    EXPECT_THROW(pycpp::ShareColumns(TradeColumns{ { 1.0 }, {}, {}, {} }), pycpp::Error);
+}
+
+TEST(ColumnsTests, ExtractColumns)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    pycpp::Object globals = PyDict_New();
+    PyDict_SetItemString(globals.get(), "__builtins__", PyEval_GetBuiltins());
+    pycpp::Object result = PyRun_String(
+        "import dataclasses\n"
+        "class Slotted:\n"
+        "    __slots__ = ('price', 'quantity', 'buy', 'symbol')\n"
+        "    def __init__(self, i):\n"
+        "        self.price, self.quantity, self.buy, self.symbol = i * 0.5, i, i % 2 == 0, 'S' + str(i)\n"
+        "@dataclasses.dataclass\n"
+        "class Plain:\n"
+        "    price: float\n"
+        "    quantity: int\n"
+        "    buy: bool\n"
+        "    symbol: str\n"
+        "slotted = [Slotted(i) for i in range(1000)]\n"
+        "mixed = [Slotted(1), Plain(2.5, 2, False, 'P'), Slotted(3)]\n"
+        "unset = Slotted(4)\n"
+        "del unset.price\n"
+        "unset = [unset]\n"
+        "class Clearing:\n"
+        "    def __init__(self, i):\n"
+        "        self.price, self.buy, self.symbol = i * 0.5, True, 'S' + str(i)\n"
+        "    @property\n"
+        "    def quantity(self):\n"
+        "        clearing.clear()\n"
+        "        return 7\n"
+        "clearing = [Clearing(i) for i in range(3)]\n"
+        "class Failing:\n"
+        "    price, quantity, symbol = 3.0, 3, 'F'\n"
+        "    @property\n"
+        "    def buy(self):\n"
+        "        raise ValueError('buy')\n"
+        "failing = [Slotted(5), Failing()]\n",
+        Py_file_input, globals.get(), globals.get());
+    ASSERT_TRUE(result);
+    const pycpp::Dict<std::string, pycpp::Object> objects(globals);
+
+    const auto trades = pycpp::ExtractColumns<TradeColumns>(objects.at("slotted"));
+    ASSERT_EQ(trades.price.size(), 1000u);
+    EXPECT_EQ(trades.price[999], 499.5);
+    EXPECT_EQ(trades.quantity[998], 998L);
+    EXPECT_TRUE(trades.buy[0]);
+    EXPECT_EQ(trades.symbol[12], "S12");
+
+    // appends, and copes with objects of different types
+    TradeColumns mixed{ { 0.0 }, { 0 }, { false }, { "" } };
+    pycpp::ExtractColumns(objects.at("mixed"), mixed);
+    EXPECT_EQ(mixed.price, (std::vector<double>{ 0.0, 0.5, 2.5, 1.5 }));
+    EXPECT_EQ(mixed.symbol[2], "P");
+
+    EXPECT_THROW((void)pycpp::ExtractColumns<TradeColumns>(objects.at("unset")), pycpp::AttributeError);
+    EXPECT_THROW((void)pycpp::ExtractColumns<TradeColumns>(pycpp::ToObject(1L)), pycpp::TypeError);
+
+    // the list is emptied while its items are read
+    const auto cleared = pycpp::ExtractColumns<TradeColumns>(objects.at("clearing"));
+    EXPECT_EQ(cleared.quantity, (std::vector<long>{ 7, 7, 7 }));
+    EXPECT_EQ(cleared.symbol[2], "S2");
+
+    // a failing row is dropped from all columns
+    TradeColumns partial{ { 0.0 }, { 0 }, { false }, { "" } };
+    EXPECT_THROW(pycpp::ExtractColumns(objects.at("failing"), partial), pycpp::ValueError);
+    EXPECT_EQ(partial.price, (std::vector<double>{ 0.0, 2.5 }));
+    EXPECT_EQ(partial.quantity.size(), 2u);
+    EXPECT_EQ(partial.buy.size(), 2u);
+    EXPECT_EQ(partial.symbol.size(), 2u);
+}
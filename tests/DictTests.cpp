@@ -0,0 +1,81 @@
+#include "PythonCpp.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <unordered_map>
+
+TEST(DictTests, BulkRoundTrip)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    std::unordered_map<std::string, double> weights;
+    for (int idx = 0; idx < 100; ++idx)
+        weights.emplace("w" + std::to_string(idx), 0.5 * idx);
+
+    const pycpp::Dict dict(weights);
+    EXPECT_EQ(dict.size(), weights.size());
+    EXPECT_EQ(dict.ToMap(), weights);
+
+    const std::map<long, std::string> ordered{ { 2L, "b" }, { 1L, "a" } };
+    EXPECT_EQ((pycpp::Dict(ordered).ToMap<std::map<long, std::string>>()), ordered);
+
+    size_t count = 0;
+    for (const auto& [key, value] : dict)
+    {
+        EXPECT_EQ(weights.at(key), value);
+        ++count;
+    }
+    EXPECT_EQ(count, weights.size());
+    const pycpp::Dict<long, long> empty;
+    EXPECT_TRUE(empty.begin() == empty.end());
+}
+
+TEST(DictTests, Lookups)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    pycpp::Dict<std::string, long> dict({ { "a", 1L }, { "b", 2L } });
+    dict.set("c", 3L);
+    EXPECT_EQ(dict.at("c"), 3L);
+    EXPECT_TRUE(dict.contains("a"));
+    EXPECT_FALSE(dict.contains("d"));
+    EXPECT_EQ(dict.get("d", -1L), -1L);
+    EXPECT_THROW((void)dict.at("d"), pycpp::KeyError);
+
+    const auto missing = dict.TryAt("d");
+    ASSERT_FALSE(missing);
+    EXPECT_TRUE(missing.error().Matches(PyExc_KeyError));
+
+    dict.erase("a");
+    EXPECT_FALSE(dict.contains("a"));
+    EXPECT_THROW(dict.erase("a"), pycpp::KeyError);
+
+    // wrong value types are reported, not unboxed
+    pycpp::Dict<std::string, pycpp::Object> mixed({ { "x", pycpp::ToObject("text") } });
+    const pycpp::Dict<std::string, long> asLong = pycpp::Object(mixed);
+    EXPECT_THROW((void)asLong.at("x"), pycpp::TypeError);
+}
+
+TEST(DictTests, KnownHashKeys)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    static const pycpp::AttributeName priceName("price");
+    const pycpp::DictKey price("price");
+    const pycpp::DictKey byName(priceName);
+    const pycpp::DictKey id(7L);
+
+    // str keys are interned so they are the same object as other interned names
+    EXPECT_EQ(price.Get(), byName.Get());
+
+    pycpp::Dict<pycpp::Object, double> record;
+    record.set(price, 2.5);
+    record.set(id, 1.0);
+    EXPECT_EQ(record.at(price), 2.5);
+    EXPECT_EQ(record.at(byName), 2.5);
+    EXPECT_TRUE(record.contains(id));
+    EXPECT_EQ(record.get(pycpp::DictKey("missing"), 0.0), 0.0);
+    EXPECT_THROW((void)record.at(pycpp::DictKey("missing")), pycpp::KeyError);
+
+    // unhashable keys fail when the key is created
+    EXPECT_THROW(pycpp::DictKey(pycpp::Object(pycpp::List<long>({ 1L }))), pycpp::TypeError);
+}
@@ -0,0 +1,85 @@
+#include "PythonCpp.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    long Add(long a, long b)
+    {
+        return a + b;
+    }
+}
+
+TEST(FunctionTests, ConvertsArgumentsAndResult)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    pycpp::Function add("add", &Add);
+    EXPECT_EQ(pycpp::python_cast<long>(add(2L, 3L)), 5);
+    EXPECT_EQ(pycpp::python_cast<std::string>(add.GetAttribute("__name__")), "add");
+
+    pycpp::Function greet("greet", [](const std::string& name, std::string_view greeting) { return std::string(greeting) + ", " + name; });
+    EXPECT_EQ(pycpp::python_cast<std::string>(greet("Bob", "Hello")), "Hello, Bob");
+
+    std::vector<long> seen;
+    pycpp::Function record("record", [&seen](long value) { seen.push_back(value); });
+    EXPECT_EQ(record(7L).get(), Py_None);
+
+    // Python code calls it like a builtin
+    auto builtins = pycpp::ImportModule("builtins");
+    pycpp::Callable mapFn = builtins.GetAttribute("map");
+    pycpp::Callable listFn = builtins.GetAttribute("list");
+    listFn(mapFn(record, pycpp::List<long>({ 1, 2, 3 })));
+    EXPECT_EQ(seen, (std::vector<long>{ 7, 1, 2, 3 }));
+
+    pycpp::Function identity("identity", [](pycpp::Object value) { return value; });
+    const auto list = pycpp::List<long>({ 1 });
+    const auto refCnt = Py_REFCNT(list.get());
+    EXPECT_EQ(identity(list).get(), list.get());
+    EXPECT_EQ(Py_REFCNT(list.get()), refCnt);
+}
+
+TEST(FunctionTests, TranslatesErrors)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    pycpp::Function add("add", &Add);
+    EXPECT_THROW(add(1L), pycpp::TypeError);
+    EXPECT_THROW(add(1L, 2L, 3L), pycpp::TypeError);
+    EXPECT_THROW(add("1", 2L), pycpp::TypeError);
+
+    pycpp::Function fail("fail", [](long kind) -> long
+        {
+            switch (kind)
+            {
+            case 0: throw std::out_of_range("out of range");
+            case 1: throw std::invalid_argument("invalid");
+            case 2: throw pycpp::KeyError("key");
+            default: throw std::runtime_error("runtime");
+            }
+        });
+    EXPECT_THROW(fail(0L), pycpp::IndexError);
+    EXPECT_THROW(fail(1L), pycpp::ValueError);
+    EXPECT_THROW(fail(2L), pycpp::KeyError);
+    try
+    {
+        fail(3L);
+        FAIL();
+    }
+    catch (const pycpp::Error& e)
+    {
+        EXPECT_TRUE(e.Matches(PyExc_RuntimeError));
+        EXPECT_NE(std::string(e.what()).find("runtime"), std::string::npos);
+    }
+
+    pycpp::Function checked("checked", [](long value) -> pycpp::Result<long>
+        {
+            if (value < 0)
+                return pycpp::try_python_cast<long>(pycpp::ToObject("negative"));
+            return value * 2;
+        });
+    EXPECT_EQ(pycpp::python_cast<long>(checked(4L)), 8);
+    EXPECT_THROW(checked(-1L), pycpp::TypeError);
+}
@@ -0,0 +1,221 @@
+#include "PythonCpp.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+TEST(InterpreterTests, WorkerThreadsAcquireGIL)
+{
+    auto handle = pycpp::Interpreter::Handle();
+    EXPECT_TRUE(pycpp::detail::HoldsGIL());
+
+    std::atomic<long> total{ 0 };
+    {
+        pycpp::GILRelease release;
+        EXPECT_FALSE(pycpp::detail::HoldsGIL());
+
+        std::vector<std::thread> workers;
+        for (int worker = 0; worker < 4; ++worker)
+        {
+            workers.emplace_back([&total]()
+                {
+                    for (int call = 0; call < 100; ++call)
+                    {
+                        pycpp::GILAcquire gil;
+                        pycpp::GILAcquire nested;
+                        pycpp::Callable absFn = pycpp::ImportModule("builtins").GetAttribute("abs");
+                        total += pycpp::python_cast<long>(absFn(-1L));
+                    }
+                });
+        }
+        for (auto& worker : workers)
+            worker.join();
+    }
+    EXPECT_TRUE(pycpp::detail::HoldsGIL());
+    EXPECT_EQ(total, 400);
+}
+
+TEST(InterpreterTests, ThreadStateIsReused)
+{
+    auto handle = pycpp::Interpreter::Handle();
+    pycpp::GILRelease release;
+
+    std::thread worker([]()
+        {
+            PyThreadState* pFirst = nullptr;
+            {
+                pycpp::GILAcquire gil;
+                pFirst = PyThreadState_Get();
+            }
+            EXPECT_FALSE(pycpp::detail::HoldsGIL());
+            {
+                pycpp::GILAcquire gil;
+                EXPECT_EQ(PyThreadState_Get(), pFirst);
+            }
+        });
+    worker.join();
+}
+
+TEST(InterpreterTests, ThreadsExitWhileGILIsHeld)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    PyThreadState* pWorkerState = nullptr;
+    std::atomic<bool> used{ false };
+    std::atomic<bool> exit{ false };
+    std::thread worker;
+    {
+        pycpp::GILRelease release;
+        worker = std::thread([&]()
+            {
+                {
+                    pycpp::GILAcquire gil;
+                    pWorkerState = PyThreadState_Get();
+                }
+                used = true;
+                while (!exit)
+                    std::this_thread::yield();
+            });
+        while (!used)
+            std::this_thread::yield();
+    }
+
+    // the worker exits and is joined while this thread holds the GIL
+    EXPECT_TRUE(pycpp::detail::HoldsGIL());
+    exit = true;
+    worker.join();
+
+    // its thread state is deleted by the next thread that takes the GIL
+    {
+        pycpp::GILRelease release;
+    }
+    bool found = false;
+    for (auto* pThreadState = PyInterpreterState_ThreadHead(PyInterpreterState_Main()); pThreadState; pThreadState = PyThreadState_Next(pThreadState))
+        found |= pThreadState == pWorkerState;
+    EXPECT_FALSE(found);
+}
+
+TEST(InterpreterTests, HandlesAcrossThreads)
+{
+    auto handle = pycpp::Interpreter::Handle();
+    pycpp::GILRelease release;
+
+    std::vector<std::thread> workers;
+    for (int worker = 0; worker < 4; ++worker)
+    {
+        workers.emplace_back([]()
+            {
+                for (int open = 0; open < 100; ++open)
+                {
+                    auto nestedHandle = pycpp::Interpreter::Handle();
+                    nestedHandle.Release();
+                }
+            });
+    }
+    for (auto& worker : workers)
+        worker.join();
+}
+
+TEST(InterpreterTests, PoolRunsTasksInSubInterpreters)
+{
+    auto handle = pycpp::Interpreter::Handle();
+    const auto mainKey = pycpp::detail::CurrentInterpreterKey();
+
+    pycpp::InterpreterPool pool(2);
+    ASSERT_EQ(pool.size(), 2u);
+    EXPECT_NE(pool.Key(0), mainKey);
+    EXPECT_NE(pool.Key(0), pool.Key(1));
+
+    pycpp::GILRelease release;
+    auto imports = pool.Broadcast([]() { return pycpp::detail::CurrentInterpreterKey(); });
+    EXPECT_EQ(imports[0].get(), pool.Key(0));
+    EXPECT_EQ(imports[1].get(), pool.Key(1));
+
+    std::vector<std::future<long>> results;
+    for (long task = 0; task < 20; ++task)
+    {
+        results.push_back(pool.Submit([task]()
+            {
+                pycpp::Callable absFn = pycpp::ImportModule("builtins").GetAttribute(PYCPP_NAME("abs"));
+                return pycpp::python_cast<long>(absFn(-task));
+            }));
+    }
+    long total = 0;
+    for (auto& result : results)
+        total += result.get();
+    EXPECT_EQ(total, 190);
+
+    auto failed = pool.Submit([]() { return pycpp::python_cast<long>(pycpp::ImportModule("no_such_module_pycpp")); });
+    EXPECT_THROW(failed.get(), pycpp::Error);
+}
+
+TEST(InterpreterTests, PinnedObjectsStayInTheirInterpreter)
+{
+    auto handle = pycpp::Interpreter::Handle();
+    pycpp::InterpreterPool pool(2);
+    pycpp::GILRelease release;
+
+    auto pinned = pool.SubmitTo(0, []() { return pycpp::PinnedObject(pycpp::ImportModule("json")); }).get();
+    ASSERT_TRUE(pinned);
+    EXPECT_EQ(pinned.Owner(), pool.Key(0));
+
+    auto name = pool.SubmitTo(pinned.Owner(), [&pinned]()
+        {
+            return pycpp::python_cast<std::string>(pinned.get().GetAttribute("__name__"));
+        });
+    EXPECT_EQ(name.get(), "json");
+
+    auto misuse = pool.SubmitTo(1, [&pinned]() { return static_cast<bool>(pinned.get()); });
+    EXPECT_THROW(misuse.get(), pycpp::Error);
+
+    // released by the worker owning the interpreter
+    pinned = pycpp::PinnedObject();
+}
+
+TEST(InterpreterTests, LocalRefsReuseSlotsOfEndedInterpreters)
+{
+    auto handle = pycpp::Interpreter::Handle();
+    const pycpp::detail::InterpreterLocalRef ref;
+
+    for (int round = 0; round < 5; ++round)
+    {
+        pycpp::InterpreterPool pool(2);
+        pycpp::GILRelease release;
+        auto objects = pool.Broadcast([&ref]() { return ref.Get([]() { return pycpp::Object(PyLong_FromLong(1)); }) != nullptr; });
+        EXPECT_TRUE(objects[0].get());
+        EXPECT_TRUE(objects[1].get());
+    }
+    EXPECT_EQ(ref.SlotCount(), 2u);
+}
+
+TEST(InterpreterTests, ExecutorRunsSubmittedCalls)
+{
+    auto handle = pycpp::Interpreter::Handle();
+    pycpp::Callable absFn = pycpp::ImportModule("builtins").GetAttribute("abs");
+    pycpp::Callable intFn = pycpp::ImportModule("builtins").GetAttribute("int");
+
+    pycpp::Interpreter::Executor executor;
+    pycpp::GILRelease release;
+
+    std::vector<std::thread> clients;
+    std::atomic<long> total{ 0 };
+    for (int client = 0; client < 4; ++client)
+    {
+        clients.emplace_back([&]()
+            {
+                std::vector<std::future<long>> results;
+                for (long call = 0; call < 100; ++call)
+                    results.push_back(executor.Submit<long>(absFn, -call));
+                for (auto& result : results)
+                    total += result.get();
+            });
+    }
+    for (auto& client : clients)
+        client.join();
+    EXPECT_EQ(total, 4 * 4950);
+
+    auto failed = executor.Submit<long>(intFn, "not a number");
+    EXPECT_THROW(failed.get(), pycpp::Error);
+
+    auto name = executor.Submit([]() { return pycpp::python_cast<std::string>(pycpp::ImportModule("json").GetAttribute("__name__")); });
+    EXPECT_EQ(name.get(), "json");
+}
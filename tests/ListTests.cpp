@@ -0,0 +1,110 @@
+#include "PythonCpp.h"
+#include <gtest/gtest.h>
+#include <limits>
+
+TEST(ListTests, BulkRoundTrip)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    std::vector<double> doubles(1000);
+    std::vector<long long> ints(1000);
+    for (size_t idx = 0; idx < doubles.size(); ++idx)
+    {
+        doubles[idx] = 0.5 * static_cast<double>(idx);
+        ints[idx] = static_cast<long long>(idx) - 500;
+    }
+
+    EXPECT_EQ(pycpp::List(doubles).ToVector(), doubles);
+    EXPECT_EQ(pycpp::List(ints).ToVector(), ints);
+
+    const std::vector<std::string> strings{ "a", "bc", "" };
+    EXPECT_EQ(pycpp::List(strings).ToVector(), strings);
+}
+
+TEST(ListTests, SlowPathConversion)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    // multi digit ints can not be unboxed directly
+    const std::vector<long long> bigInts{ 1, std::numeric_limits<long long>::max(), std::numeric_limits<long long>::min() };
+    EXPECT_EQ(pycpp::List(bigInts).ToVector(), bigInts);
+
+    // negative values do not fit into unsigned types
+    const pycpp::Object negative = pycpp::List<long>({ 1L, -1L });
+    const pycpp::List<unsigned long> asUnsigned = negative;
+    EXPECT_THROW(asUnsigned.ToVector(), pycpp::Error);
+
+    // ints in a float list are not unboxed directly but still converted by python_cast
+    pycpp::List<double> mixed({ 1.5 });
+    mixed.append(pycpp::ToObject(2L));
+    EXPECT_EQ(mixed.ToVector(), (std::vector<double>{ 1.5, 2.0 }));
+}
+
+TEST(ListTests, RefCountsOfObjectElements)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    const pycpp::List<long> element({ 1L });
+    const auto refCnt = Py_REFCNT(element.get());
+    {
+        pycpp::List<pycpp::List<long>> list({ element, element });
+        EXPECT_EQ(Py_REFCNT(element.get()), refCnt + 2);
+    }
+    EXPECT_EQ(Py_REFCNT(element.get()), refCnt);
+}
+
+TEST(ListTests, Iterators)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    const pycpp::List<long> list({ 3L, 1L, 2L });
+    static_assert(std::random_access_iterator<pycpp::List<long>::const_iterator>);
+
+    EXPECT_EQ(std::vector<long>(list.begin(), list.end()), (std::vector<long>{ 3, 1, 2 }));
+    EXPECT_EQ(*std::ranges::max_element(list), 3);
+    EXPECT_EQ(list.end() - list.begin(), 3);
+    EXPECT_EQ(list.begin()[2], 2);
+
+    const pycpp::Tuple<long, std::string> tuple(1L, std::string("a"));
+    EXPECT_EQ(std::distance(tuple.begin(), tuple.end()), 2);
+    EXPECT_EQ(pycpp::python_cast<std::string>(*(tuple.begin() + 1)), "a");
+}
+
+TEST(ListTests, IterableOverGenerator)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    pycpp::Callable rangeFn = pycpp::ImportModule("builtins").GetAttribute("range");
+    const pycpp::Iterable<long> range = rangeFn(5L);
+
+    long sum = 0;
+    for (const auto value : range)
+        sum += value;
+    EXPECT_EQ(sum, 10);
+
+    // a map object is a one-shot iterator
+    pycpp::Callable mapFn = pycpp::ImportModule("builtins").GetAttribute("map");
+    const pycpp::Iterable<std::string> strings = mapFn(pycpp::ImportModule("builtins").GetAttribute("str"), range);
+    std::vector<std::string> converted;
+    for (const auto& str : strings)
+        converted.push_back(str);
+    EXPECT_EQ(converted, (std::vector<std::string>{ "0", "1", "2", "3", "4" }));
+    EXPECT_EQ(strings.begin(), std::default_sentinel);
+
+    const pycpp::Iterable<long> notIterable = pycpp::ToObject(1L);
+    EXPECT_THROW(notIterable.begin(), pycpp::Error);
+}
+
+TEST(ListTests, ConversionsStealReferences)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    const pycpp::List<long> element({ 1L });
+    const auto refCnt = Py_REFCNT(element.get());
+    {
+        pycpp::List<pycpp::List<long>> list({ element });
+        list[0] = element;
+        EXPECT_EQ(Py_REFCNT(element.get()), refCnt + 1);
+    }
+    EXPECT_EQ(Py_REFCNT(element.get()), refCnt);
+}
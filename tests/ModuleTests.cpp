@@ -0,0 +1,61 @@
+#include "PythonCpp.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+    bool IsLoaded(const char* pName)
+    {
+        return PyDict_GetItemString(PyImport_GetModuleDict(), pName) != nullptr;
+    }
+}
+
+TEST(ModuleTests, CachesImports)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    const auto json = pycpp::ModuleCache::Import("json");
+    EXPECT_EQ(json.get(), PyDict_GetItemString(PyImport_GetModuleDict(), "json"));
+
+    // served from the cache, even once it is gone from sys.modules
+    ASSERT_EQ(PyDict_DelItemString(PyImport_GetModuleDict(), "json"), 0);
+    EXPECT_EQ(pycpp::ModuleCache::Import("json").get(), json.get());
+    ASSERT_EQ(PyDict_SetItemString(PyImport_GetModuleDict(), "json", json.get()), 0);
+
+    EXPECT_EQ(pycpp::ModuleCache::Import("os.path").get(), pycpp::ImportModule("os.path").get());
+
+    const auto failed = pycpp::ModuleCache::TryImport("no_such_module");
+    ASSERT_FALSE(failed);
+    EXPECT_TRUE(failed.error().Matches(PyExc_ImportError));
+    EXPECT_THROW(pycpp::ModuleCache::Import("no_such_module"), pycpp::ImportError);
+}
+
+TEST(ModuleTests, LazyModuleImportsOnFirstUse)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    ASSERT_FALSE(IsLoaded("colorsys"));
+    const pycpp::LazyModule colorsys("colorsys");
+    EXPECT_FALSE(IsLoaded("colorsys"));
+
+    pycpp::Callable rgbToHsv = colorsys.GetAttribute("rgb_to_hsv");
+    EXPECT_TRUE(IsLoaded("colorsys"));
+    EXPECT_EQ(colorsys.Get().get(), pycpp::ModuleCache::Import("colorsys").get());
+    EXPECT_EQ(pycpp::python_cast<double>(pycpp::Tuple<pycpp::Object, pycpp::Object, pycpp::Object>(rgbToHsv(1.0, 1.0, 1.0)).at<2>()), 1.0);
+
+    const pycpp::LazyModule missing("no_such_module");
+    EXPECT_THROW((void)missing.Get(), pycpp::ImportError);
+}
+
+TEST(ModuleTests, PrewarmImportsInTheBackground)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    ASSERT_FALSE(IsLoaded("fractions"));
+    pycpp::ModulePrewarm prewarm({ "fractions", "no_such_module", "difflib" });
+    EXPECT_THROW(prewarm.Wait(), pycpp::ImportError);
+    EXPECT_NO_THROW(prewarm.Wait());
+
+    EXPECT_TRUE(IsLoaded("fractions"));
+    EXPECT_TRUE(IsLoaded("difflib"));
+    EXPECT_EQ(pycpp::ModuleCache::Import("difflib").get(), pycpp::ImportModule("difflib").get());
+}
@@ -0,0 +1,31 @@
+#include "PythonCpp.h"
+#include <gtest/gtest.h>
+#include <string>
+
+TEST(ObjectTests, ReleaseOwnershipHandsOverTheReference)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    pycpp::Object owner = pycpp::ToObject(42L);
+    const auto refCnt = Py_REFCNT(owner.get());
+    PyObject* pObject = owner.ReleaseOwnership();
+    EXPECT_FALSE(owner);
+    EXPECT_EQ(Py_REFCNT(pObject), refCnt);
+
+    pycpp::Object adopted(pObject);
+    EXPECT_EQ(pycpp::python_cast<long>(adopted), 42L);
+}
+
+TEST(ObjectTests, TupleConversionStealsReferences)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    const pycpp::List<long> element({ 1L });
+    const auto refCnt = Py_REFCNT(element.get());
+    {
+        const pycpp::Tuple tuple(element, 2L, std::string("three"));
+        EXPECT_EQ(Py_REFCNT(element.get()), refCnt + 1);
+        EXPECT_EQ(tuple.at<2>(), "three");
+    }
+    EXPECT_EQ(Py_REFCNT(element.get()), refCnt);
+}
@@ -0,0 +1,69 @@
+#include "PythonCpp.h"
+#include <gtest/gtest.h>
+#include <future>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+
+TEST(ProcessPoolTests, CallsFunctionsInWorkers)
+{
+    auto handle = pycpp::Interpreter::Handle();
+    pycpp::ProcessPool pool(2);
+    EXPECT_EQ(pool.size(), 2);
+
+    std::vector<std::future<double>> results;
+    for (int idx = 0; idx < 20; ++idx)
+        results.push_back(pool.Submit<double>("math.sqrt", idx * idx));
+    for (int idx = 0; idx < 20; ++idx)
+        EXPECT_DOUBLE_EQ(results[idx].get(), idx);
+
+    EXPECT_EQ(pool.Submit<std::string>("builtins.str", 42).get(), "42");
+    EXPECT_TRUE(pool.Submit<bool>("builtins.callable", "math").get() == false);
+    pool.Submit("builtins.len", "abc").get();
+    EXPECT_EQ(pool.Submit<long>("builtins.abs", -3).get(), 3);
+    EXPECT_EQ(pool.Submit<uint8_t>("builtins.abs", -255).get(), 255);
+    EXPECT_THROW(pool.Submit<uint8_t>("builtins.abs", -256).get(), pycpp::OverflowError);
+    EXPECT_THROW(pool.Submit<unsigned>("builtins.int", -1).get(), pycpp::OverflowError);
+}
+
+TEST(ProcessPoolTests, BuffersArriveAsMemoryViews)
+{
+    auto handle = pycpp::Interpreter::Handle();
+    pycpp::ProcessPool pool(1, 1 << 16);
+
+    const std::vector<double> values{ 1.5, 2.5, 3.0 };
+    EXPECT_DOUBLE_EQ(pool.Submit<double>("builtins.sum", values).get(), 7.0);
+    EXPECT_EQ(pool.Submit<std::string>("builtins.bytes", values).get().size(), sizeof(double) * values.size());
+
+    const std::vector<int> ints{ 1, 2, 3 };
+    EXPECT_EQ(pool.Submit<std::vector<int>>("builtins.memoryview", ints).get(), ints);
+    EXPECT_THROW(pool.Submit<std::vector<double>>("builtins.memoryview", ints).get(), pycpp::Error);
+
+    // wraps around the rings many times
+    const std::vector<double> ones(1000, 1.0);
+    std::vector<std::future<double>> sums;
+    for (int idx = 0; idx < 200; ++idx)
+        sums.push_back(pool.Submit<double>("builtins.sum", ones));
+    for (auto& sum : sums)
+        EXPECT_DOUBLE_EQ(sum.get(), 1000.0);
+
+    // larger than half the ring
+    const std::vector<double> large(1 << 14);
+    EXPECT_THROW(pool.Submit<double>("builtins.sum", large), pycpp::Error);
+}
+
+TEST(ProcessPoolTests, ErrorsAreRethrown)
+{
+    auto handle = pycpp::Interpreter::Handle();
+    pycpp::ProcessPool pool(1);
+
+    EXPECT_THROW(pool.Submit<double>("math.sqrt", -1.0).get(), pycpp::Error);
+    EXPECT_THROW(pool.Submit("math.does_not_exist").get(), pycpp::Error);
+    EXPECT_THROW(pool.Submit("no_such_module.function").get(), pycpp::Error);
+    EXPECT_THROW(pool.Submit<double>("builtins.str", 1).get(), pycpp::Error);
+    // the worker is still usable afterwards
+    EXPECT_DOUBLE_EQ(pool.Submit<double>("math.sqrt", 4.0).get(), 2.0);
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include "PythonCpp.h"
 #include <gtest/gtest.h>
+#include <memory>
+#include <thread>
 
 // Types that we expect to succeed
 #define PYTHON_BASE_TYPES int,                \
@@ -141,3 +143,82 @@ TEST(PythonTypeTraitsTests, BasicStringConversionTests)
     auto handle = pycpp::Interpreter::Handle();
     detail::BasicConversionTest<PYTHON_STRING_TYPES>();
 }
+
+TEST(PythonTypeTraitsTests, TryConversionTests)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    const auto number = pycpp::ToObject(42L);
+    const auto text = pycpp::ToObject("text");
+
+    auto value = pycpp::try_python_cast<long>(number);
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*value, 42);
+
+    auto failed = pycpp::try_python_cast<long>(text);
+    EXPECT_FALSE(failed);
+    EXPECT_TRUE(failed.error().Matches(PyExc_TypeError));
+    EXPECT_FALSE(PyErr_Occurred());
+    EXPECT_EQ(failed.value_or(-1), -1);
+    EXPECT_THROW((void)failed.value(), pycpp::TypeError);
+
+    EXPECT_EQ(pycpp::try_python_cast<std::string>(text).value(), "text");
+    EXPECT_FALSE(pycpp::try_python_cast<double>(text));
+    EXPECT_FALSE(pycpp::try_python_cast<pycpp::List<long>>(number));
+    EXPECT_THROW((void)pycpp::python_cast<long>(text), pycpp::TypeError);
+
+    // errors thrown on the C++ side keep their type and message
+    const auto caught = pycpp::detail::CatchErrors<long>([]() -> pycpp::Result<long> { throw pycpp::KeyError("missing key"); });
+    ASSERT_FALSE(caught);
+    try
+    {
+        (void)caught.value();
+        FAIL();
+    }
+    catch (const pycpp::KeyError& e)
+    {
+        EXPECT_STREQ(e.what(), "missing key");
+    }
+    caught.error().Restore();
+    EXPECT_TRUE(PyErr_ExceptionMatches(PyExc_RuntimeError));
+    PyErr_Clear();
+
+    // the exception objects are released with the GIL, also from threads that do not hold it
+    auto released = std::make_unique<pycpp::Result<long>>(pycpp::try_python_cast<long>(text));
+    {
+        pycpp::GILRelease release;
+        std::thread([&released]() { released.reset(); }).join();
+    }
+    EXPECT_FALSE(released);
+}
+
+TEST(PythonTypeTraitsTests, StringViewAndBytesTests)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    // sized strings may contain null characters
+    const std::string withNull("a\0b", 3);
+    const auto str = pycpp::ToObject(withNull);
+    const auto view = pycpp::python_cast<std::string_view>(str);
+    EXPECT_EQ(view, std::string_view(withNull));
+    EXPECT_EQ(view.data(), pycpp::python_cast<std::string_view>(str).data());
+    EXPECT_FALSE(pycpp::try_python_cast<std::string_view>(pycpp::ToObject(1L).get()));
+    // containers and bulk conversions cast temporary items, so they do not take views
+    static_assert(!pycpp::isPythonBaseType_v<std::string_view>);
+
+    const pycpp::Bytes bytes(4, [](std::span<std::byte> out)
+        {
+            for (size_t idx = 0; idx < out.size(); ++idx)
+                out[idx] = static_cast<std::byte>(idx);
+        });
+    ASSERT_EQ(bytes.size(), 4u);
+    EXPECT_EQ(bytes.View()[3], std::byte{ 3 });
+
+    const auto len = pycpp::Callable(pycpp::ImportModule("builtins").GetAttribute("len"));
+    EXPECT_EQ(pycpp::python_cast<long>(len.Invoke(bytes)), 4L);
+
+    const auto fromView = pycpp::python_cast<pycpp::Bytes>(pycpp::Object(pycpp::Bytes(std::string_view("payload"))));
+    EXPECT_EQ(fromView.StringView(), "payload");
+    EXPECT_EQ(pycpp::Bytes().size(), 0u);
+    EXPECT_THROW(pycpp::Bytes(pycpp::Object(str)), pycpp::Error);
+}
@@ -0,0 +1,70 @@
+#include "PythonCpp.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace geo
+{
+    struct Point
+    {
+        double x = 0.0;
+        double y = 0.0;
+    };
+
+    struct Place
+    {
+        std::string name;
+        Point location;
+        long visits = 0;
+    };
+}
+
+PYCPP_RECORD(geo::Point, x, y)
+PYCPP_RECORD(geo::Place, name, location, visits)
+
+TEST(RecordTests, RoundTrip)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    static_assert(pycpp::isPythonBaseType_v<geo::Place>);
+    const geo::Place place{ "home", { 1.5, -2.0 }, 3 };
+    const auto obj = pycpp::ToObject(place);
+    EXPECT_EQ(std::string(Py_TYPE(obj.get())->tp_name), "pycpp.Place");
+    EXPECT_EQ(pycpp::python_cast<long>(obj.GetAttribute("visits")), 3L);
+    EXPECT_EQ(pycpp::python_cast<double>(obj.GetAttribute("location").GetAttribute("y")), -2.0);
+
+    const auto back = pycpp::python_cast<geo::Place>(obj);
+    EXPECT_EQ(back.name, "home");
+    EXPECT_EQ(back.location.x, 1.5);
+    EXPECT_EQ(back.visits, 3L);
+
+    // the type is created once
+    EXPECT_EQ(Py_TYPE(pycpp::ToObject(geo::Point{}).get()), Py_TYPE(obj.GetAttribute("location").get()));
+}
+
+TEST(RecordTests, ListsAndOtherObjects)
+{
+    auto handle = pycpp::Interpreter::Handle();
+
+    std::vector<geo::Point> points(1000);
+    for (size_t idx = 0; idx < points.size(); ++idx)
+        points[idx] = { static_cast<double>(idx), 0.5 };
+    const auto back = pycpp::List(points).ToVector();
+    ASSERT_EQ(back.size(), points.size());
+    EXPECT_EQ(back[999].x, 999.0);
+
+    // plain tuples are read by position, other objects by attribute
+    const auto fromTuple = pycpp::python_cast<geo::Point>(pycpp::Tuple(3.0, 4.0));
+    EXPECT_EQ(fromTuple.y, 4.0);
+
+    const auto types = pycpp::ImportModule("types");
+    const pycpp::Callable simpleNamespace(types.GetAttribute("SimpleNamespace"));
+    static const pycpp::Keywords kw("x", "y");
+    const auto fromAttributes = pycpp::python_cast<geo::Point>(simpleNamespace(kw(5.0, 6.0)));
+    EXPECT_EQ(fromAttributes.x, 5.0);
+    // the attribute names are resolved once per interpreter
+    EXPECT_EQ(pycpp::detail::RecordFieldNames<geo::Point>()[1], pycpp::detail::InternName("y"));
+
+    EXPECT_THROW((void)pycpp::python_cast<geo::Point>(pycpp::Tuple(1.0)), pycpp::TypeError);
+    EXPECT_THROW((void)pycpp::python_cast<geo::Point>(pycpp::Tuple(1.0, std::string("y"))), pycpp::TypeError);
+    EXPECT_THROW((void)pycpp::python_cast<geo::Point>(pycpp::ToObject(1L)), pycpp::AttributeError);
+}